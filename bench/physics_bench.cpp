@@ -0,0 +1,419 @@
+// Suite de benchmarks headless de la simulation (physique, joueur, niveau),
+// sans OpenGL : ragdolls x longueur de parcours x repos / actif.
+// Sortie CSV sur stdout :
+//   scenario,ragdolls,course_m,mode,bodies,static_bodies,sleeping_bodies,steps,
+//   ns_per_step,physics_ns_per_step,bodies_per_s,allocs_per_step
+// Au repos, les ragdolls tombent à l'écart des obstacles animés (barres,
+// plateformes mobiles) et la mesure attend qu'ils ne s'endorment plus : c'est
+// le coût des îlots endormis qui est mesuré. Un scénario au repos dont tous
+// les ragdolls ne dorment pas est signalé sur stderr et donne le code de retour 1.
+// Options :
+//   --help, -h              affiche ces options
+//   --baseline fichier.csv  compare à une sortie précédente (colonnes en plus,
+//                           code de retour 1 si un scénario régresse)
+//   --tolerance 0.10        ralentissement toléré sur ns_per_step
+//   --steps N               pas par mesure (240)
+//   --repeat N              mesures successives par scénario, la plus rapide
+//                           est gardée (3)
+//   --threads N             threads du solveur (1)
+//   --filter texte          seulement les scénarios dont le nom le contient
+//   --lod 1                 LOD physique centré sur le premier ragdoll (suffixe
+//                           _lod : le coût doit rester à peu près constant
+//                           quand le nombre de ragdolls augmente)
+// La référence doit venir de la même machine, même build (Release) ; sur une
+// machine chargée, augmenter --repeat plutôt que --tolerance.
+#include "engine/physics.h"
+#include "game/level.h"
+#include "game/player.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compteur d'allocations : toutes les formes de new passent par ici
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+void* CountedAlloc(size_t size, size_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        ptr = std::malloc(size);
+    } else {
+#if defined(_MSC_VER)
+        ptr = _aligned_malloc(size, alignment);
+#else
+        ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void CountedFree(void* ptr, size_t alignment) {
+#if defined(_MSC_VER)
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(ptr);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(ptr);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return CountedAlloc(size, 0); }
+void* operator new[](size_t size) { return CountedAlloc(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAlloc(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAlloc(size, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr) noexcept { CountedFree(ptr, 0); }
+void operator delete[](void* ptr) noexcept { CountedFree(ptr, 0); }
+void operator delete(void* ptr, size_t) noexcept { CountedFree(ptr, 0); }
+void operator delete[](void* ptr, size_t) noexcept { CountedFree(ptr, 0); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { CountedFree(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { CountedFree(ptr, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { CountedFree(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { CountedFree(ptr, static_cast<size_t>(alignment)); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Les options de l'en-tête, pour --help
+const char* const USAGE =
+    "Usage : wobbly_bench [options]\n"
+    "  --help, -h              affiche ces options\n"
+    "  --baseline fichier.csv  compare à une sortie précédente (colonnes en plus,\n"
+    "                          code de retour 1 si un scénario régresse)\n"
+    "  --tolerance 0.10        ralentissement toléré sur ns_per_step\n"
+    "  --steps N               pas par mesure (240)\n"
+    "  --repeat N              mesures successives par scénario, la plus rapide\n"
+    "                          est gardée (3)\n"
+    "  --threads N             threads du solveur (1)\n"
+    "  --filter texte          seulement les scénarios dont le nom le contient\n"
+    "  --lod 1                 LOD physique centré sur le premier ragdoll (suffixe\n"
+    "                          _lod : le coût doit rester à peu près constant\n"
+    "                          quand le nombre de ragdolls augmente)\n";
+
+const size_t RAGDOLL_COUNTS[] = {1, 10, 100, 1000};
+const float COURSE_LENGTHS[] = {50.0f, 500.0f, 5000.0f};
+const float PHYSICS_RATE_HZ = 120.0f;
+const int WARMUP_STEPS = 240;         // Chute avant la mesure
+const int SETTLE_INTERVAL = 240;      // Au repos : pas entre deux relevés des corps endormis
+const int MAX_SETTLE_STEPS = 2400;    // Au repos : limite de l'attente du sommeil
+const float RESTING_LANE_X = 6.5f;    // Au repos : hors de portée des barres et plateformes mobiles
+const float COURSE_GAP = 10.0f;       // Entre la fin d'un parcours et le début du suivant
+const float RAGDOLL_SPACING = 4.0f;   // Entre deux ragdolls d'un même parcours
+
+struct Scenario {
+    size_t ragdolls;
+    float courseLength;
+    bool active;
+    bool lod;
+
+    std::string Name() const {
+        std::ostringstream name;
+        name << "r" << ragdolls << "_c" << static_cast<int>(courseLength) << (active ? "_active" : "_rest")
+             << (lod ? "_lod" : "");
+        return name.str();
+    }
+
+    // Corps qui doivent dormir au repos (les obstacles animés restent éveillés)
+    size_t RagdollBodies() const { return ragdolls * Game::RagdollPartCount; }
+};
+
+struct Result {
+    size_t bodies = 0;
+    size_t staticBodies = 0;
+    size_t sleepingBodies = 0;
+    int steps = 0;
+    double nsPerStep = 0.0;
+    double physicsNsPerStep = 0.0;
+    double bodiesPerSecond = 0.0;
+    double allocsPerStep = 0.0;
+};
+
+struct BaselineEntry {
+    std::string scenario;
+    double nsPerStep = 0.0;
+    double allocsPerStep = 0.0;
+};
+
+// Les ragdolls remplissent un parcours tous les RAGDOLL_SPACING mètres, puis
+// le parcours suivant (même longueur, graine suivante) est placé à la suite
+// sur Z, l'axe de la broadphase, comme un parcours plus long
+class BenchWorld {
+public:
+    BenchWorld(const Scenario& scenario, size_t threads) : m_scenario(scenario) {
+        m_physics.SetDeterministic(true);
+        m_physics.SetWorkerThreads(threads);
+        Engine::LodSettings lod;
+        lod.enabled = scenario.lod;
+        m_physics.SetLodSettings(lod);
+
+        const size_t perLane = std::max<size_t>(1, static_cast<size_t>((scenario.courseLength - 10.0f) / RAGDOLL_SPACING));
+        const size_t courses = (scenario.ragdolls + perLane - 1) / perLane;
+        const float courseStride = scenario.courseLength + COURSE_GAP;
+        for (size_t course = 0; course < courses; ++course) {
+            glm::vec3 origin(0.0f, 0.0f, static_cast<float>(course) * courseStride);
+            m_levels.push_back(std::make_unique<Game::Level>(&m_physics, origin));
+            m_levels.back()->GenerateObstacleCourse(scenario.courseLength, static_cast<uint32_t>(course + 1));
+        }
+        const float x = scenario.active ? 0.0f : RESTING_LANE_X;
+        for (size_t r = 0; r < scenario.ragdolls; ++r) {
+            float z = static_cast<float>(r / perLane) * courseStride + 2.0f +
+                      static_cast<float>(r % perLane) * RAGDOLL_SPACING;
+            m_players.push_back(std::make_unique<Game::Player>(&m_physics, glm::vec3(x, 3.0f, z)));
+        }
+
+        // Propriétaire de chaque corps (par emplacement de handle), pour
+        // distribuer les contacts sans que chaque joueur lise tout le flux
+        m_owners.assign(m_physics.GetBodies().SlotCount(), NoOwner);
+        for (size_t r = 0; r < m_players.size(); ++r) {
+            for (Engine::BodyHandle part : m_players[r]->GetParts()) {
+                m_owners[part.index] = static_cast<uint32_t>(r);
+            }
+        }
+    }
+
+    // Un pas de jeu ; retourne la durée de PhysicsEngine::Update
+    Clock::duration Step() {
+        const float dt = 1.0f / PHYSICS_RATE_HZ;
+        if (m_scenario.active) {
+            // Chaque ragdoll court avec son propre décalage de phase
+            for (size_t r = 0; r < m_players.size(); ++r) {
+                Game::Player& player = *m_players[r];
+                size_t phase = m_frame + r * 7;
+                if (phase % 30 == 0) player.LiftLeftLeg();
+                if (phase % 30 == 15) player.LiftRightLeg();
+                if (phase % 90 == 45) player.Jump();
+                player.LeanForward();
+            }
+        }
+
+        // La caméra suit le premier ragdoll
+        if (m_scenario.lod) {
+            m_physics.SetLodFocus(m_physics.GetPosition(m_players.front()->GetParts().front()));
+        }
+
+        Clock::time_point start = Clock::now();
+        // Pas fixe (mode déterministe) : exactement un pas par Update
+        m_physics.Update(dt);
+        Clock::duration physics = Clock::now() - start;
+
+        for (const Engine::ContactEvent& contact : m_physics.GetContactEvents()) {
+            uint32_t ownerA = Owner(contact.bodyA);
+            uint32_t ownerB = Owner(contact.bodyB);
+            if (ownerA != NoOwner) m_players[ownerA]->OnContact(contact);
+            if (ownerB != NoOwner && ownerB != ownerA) m_players[ownerB]->OnContact(contact);
+        }
+        for (auto& player : m_players) player->Update(dt);
+        for (auto& level : m_levels) level->Update(dt);
+        m_frame++;
+        return physics;
+    }
+
+    const Engine::PhysicsEngine& GetPhysics() const { return m_physics; }
+
+private:
+    static constexpr uint32_t NoOwner = 0xFFFFFFFFu;
+
+    uint32_t Owner(Engine::BodyHandle body) const {
+        return body.index < m_owners.size() ? m_owners[body.index] : NoOwner;
+    }
+
+    Scenario m_scenario;
+    Engine::PhysicsEngine m_physics;
+    std::vector<std::unique_ptr<Game::Level>> m_levels;
+    std::vector<std::unique_ptr<Game::Player>> m_players;
+    std::vector<uint32_t> m_owners; // Indice du joueur, ou NoOwner
+    size_t m_frame = 0;
+};
+
+// La simulation continue d'une mesure à l'autre : la plus rapide écarte le
+// bruit de la machine, les allocations sont comptées sur toutes
+Result Run(const Scenario& scenario, int steps, int repeats, size_t threads) {
+    BenchWorld world(scenario, threads);
+    for (int i = 0; i < WARMUP_STEPS; ++i) {
+        world.Step();
+    }
+    // Les ragdolls s'endorment à des moments différents : attendre que le
+    // nombre de corps endormis cesse d'augmenter
+    if (!scenario.active) {
+        const Engine::PhysicsEngine& physics = world.GetPhysics();
+        size_t sleeping = physics.GetIslandStats().sleepingBodies;
+        for (int settled = 0; settled < MAX_SETTLE_STEPS; settled += SETTLE_INTERVAL) {
+            for (int i = 0; i < SETTLE_INTERVAL; ++i) {
+                world.Step();
+            }
+            size_t now = physics.GetIslandStats().sleepingBodies;
+            if (now <= sleeping || now >= scenario.RagdollBodies()) break;
+            sleeping = now;
+        }
+    }
+
+    double bestSeconds = 0.0;
+    double bestPhysics = 0.0;
+    uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (int r = 0; r < repeats; ++r) {
+        Clock::duration physics{};
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < steps; ++i) {
+            physics += world.Step();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (r == 0 || seconds < bestSeconds) {
+            bestSeconds = seconds;
+            bestPhysics = std::chrono::duration<double>(physics).count();
+        }
+    }
+    allocations = g_allocations.load(std::memory_order_relaxed) - allocations;
+
+    Result result;
+    result.staticBodies = world.GetPhysics().GetStaticBodyCount();
+    result.bodies = world.GetPhysics().GetBodies().Size() - result.staticBodies;
+    result.sleepingBodies = world.GetPhysics().GetIslandStats().sleepingBodies;
+    result.steps = steps;
+    result.nsPerStep = bestSeconds * 1e9 / steps;
+    result.physicsNsPerStep = bestPhysics * 1e9 / steps;
+    result.bodiesPerSecond = static_cast<double>(result.bodies) * steps / bestSeconds;
+    result.allocsPerStep = static_cast<double>(allocations) / (static_cast<double>(steps) * repeats);
+    return result;
+}
+
+// Relit une sortie précédente de ce programme (colonnes repérées par l'en-tête)
+bool LoadBaseline(const char* path, std::vector<BaselineEntry>& entries) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) return false;
+
+    std::vector<std::string> header;
+    std::istringstream headerStream(line);
+    for (std::string column; std::getline(headerStream, column, ',');) {
+        header.push_back(column);
+    }
+    auto columnOf = [&](const char* name) {
+        return static_cast<size_t>(std::find(header.begin(), header.end(), name) - header.begin());
+    };
+    const size_t scenarioColumn = columnOf("scenario");
+    const size_t nsColumn = columnOf("ns_per_step");
+    const size_t allocColumn = columnOf("allocs_per_step");
+    if (scenarioColumn == header.size() || nsColumn == header.size() || allocColumn == header.size()) return false;
+
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::istringstream lineStream(line);
+        for (std::string field; std::getline(lineStream, field, ',');) {
+            fields.push_back(field);
+        }
+        if (fields.size() < header.size()) continue;
+        entries.push_back({fields[scenarioColumn], std::atof(fields[nsColumn].c_str()),
+                           std::atof(fields[allocColumn].c_str())});
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* baselinePath = nullptr;
+    const char* filter = nullptr;
+    double tolerance = 0.10;
+    int steps = 240;
+    int repeats = 3;
+    size_t threads = 1;
+    bool lod = false;
+    for (int i = 1; i < argc; i += 2) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            std::printf("%s", USAGE);
+            return 0;
+        }
+        if (i + 1 == argc) {
+            std::fprintf(stderr, "valeur manquante : %s\n", argv[i]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--baseline") == 0) baselinePath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--tolerance") == 0) tolerance = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--steps") == 0) steps = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--repeat") == 0) repeats = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--threads") == 0) threads = static_cast<size_t>(std::max(1, std::atoi(argv[i + 1])));
+        else if (std::strcmp(argv[i], "--filter") == 0) filter = argv[i + 1];
+        else if (std::strcmp(argv[i], "--lod") == 0) lod = std::atoi(argv[i + 1]) != 0;
+        else {
+            std::fprintf(stderr, "option inconnue : %s\n%s", argv[i], USAGE);
+            return 2;
+        }
+    }
+
+    std::vector<BaselineEntry> baseline;
+    if (baselinePath && !LoadBaseline(baselinePath, baseline)) {
+        std::fprintf(stderr, "référence illisible : %s\n", baselinePath);
+        return 2;
+    }
+
+    // Les messages du jeu (génération, mouvements) ne doivent ni polluer la
+    // sortie ni coûter pendant la mesure
+    std::cout.setstate(std::ios::failbit);
+
+    std::printf("scenario,ragdolls,course_m,mode,bodies,static_bodies,sleeping_bodies,steps,ns_per_step,"
+                "physics_ns_per_step,bodies_per_s,allocs_per_step%s\n",
+                baselinePath ? ",baseline_ns_per_step,ratio,regression" : "");
+
+    int regressions = 0;
+    int unsettled = 0;
+    for (size_t ragdolls : RAGDOLL_COUNTS) {
+        for (float courseLength : COURSE_LENGTHS) {
+            for (bool active : {false, true}) {
+                Scenario scenario{ragdolls, courseLength, active, lod};
+                const std::string name = scenario.Name();
+                if (filter && name.find(filter) == std::string::npos) continue;
+
+                Result result = Run(scenario, steps, repeats, threads);
+                std::printf("%s,%zu,%.0f,%s,%zu,%zu,%zu,%d,%.0f,%.0f,%.0f,%.2f", name.c_str(), ragdolls, courseLength,
+                            active ? "active" : "rest", result.bodies, result.staticBodies, result.sleepingBodies, result.steps,
+                            result.nsPerStep, result.physicsNsPerStep, result.bodiesPerSecond, result.allocsPerStep);
+                // Une mesure au repos avec des corps éveillés ne mesure pas le repos
+                if (!active && result.sleepingBodies < scenario.RagdollBodies()) {
+                    unsettled++;
+                    std::fprintf(stderr, "%s : %zu parties de ragdoll endormies sur %zu, mesure au repos invalide\n",
+                                 name.c_str(), result.sleepingBodies, scenario.RagdollBodies());
+                }
+
+                if (baselinePath) {
+                    auto it = std::find_if(baseline.begin(), baseline.end(),
+                                           [&](const BaselineEntry& entry) { return entry.scenario == name; });
+                    if (it == baseline.end()) {
+                        std::printf(",,,0\n");
+                        continue;
+                    }
+                    double ratio = it->nsPerStep > 0.0 ? result.nsPerStep / it->nsPerStep : 1.0;
+                    // Les allocations sont déterministes : toute allocation en plus compte
+                    bool regression = ratio > 1.0 + tolerance || result.allocsPerStep > it->allocsPerStep + 0.5;
+                    if (regression) {
+                        regressions++;
+                        std::fprintf(stderr, "régression %s : %.0f ns/pas (référence %.0f), %.2f allocations/pas (référence %.2f)\n",
+                                     name.c_str(), result.nsPerStep, it->nsPerStep, result.allocsPerStep, it->allocsPerStep);
+                    }
+                    std::printf(",%.0f,%.3f,%d", it->nsPerStep, ratio, regression ? 1 : 0);
+                }
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    return regressions > 0 || unsettled > 0 ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+// Coût de SaveState / LoadState en fonction du nombre de corps.
+// Sortie CSV sur stdout : bodies,bytes,save_us,restore_us,deterministic
+#include "engine/physics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Chaînes de 9 corps reliés (comme un ragdoll) alignées le long de Z,
+// au-dessus d'un sol statique
+void BuildScene(Engine::PhysicsEngine& physics, size_t bodyCount) {
+    Engine::RigidBody ground;
+    ground.position = glm::vec3(0.0f, -0.5f, 0.0f);
+    ground.boxMin = glm::vec3(-10.0f, -0.5f, -10.0f);
+    ground.boxMax = glm::vec3(10.0f, 0.5f, 20000.0f);
+    ground.isStatic = true;
+    physics.CreateRigidBody(ground);
+
+    const size_t CHAIN = 9;
+    Engine::BodyHandle previous;
+    for (size_t i = 0; i < bodyCount; ++i) {
+        size_t chain = i / CHAIN;
+        Engine::RigidBody part;
+        part.position = glm::vec3(0.0f, 1.0f + static_cast<float>(i % CHAIN) * 0.5f,
+                                  static_cast<float>(chain));
+        part.boxMin = glm::vec3(-0.2f);
+        part.boxMax = glm::vec3(0.2f);
+        Engine::BodyHandle body = physics.CreateRigidBody(part);
+        if (i % CHAIN != 0) {
+            physics.AddConstraint(previous, body, 0.5f);
+        }
+        previous = body;
+    }
+}
+
+std::vector<float> Positions(const Engine::PhysicsEngine& physics) {
+    const Engine::BodyStore& bodies = physics.GetBodies();
+    std::vector<float> out(bodies.posX.begin(), bodies.posX.end());
+    out.insert(out.end(), bodies.posY.begin(), bodies.posY.end());
+    out.insert(out.end(), bodies.posZ.begin(), bodies.posZ.end());
+    return out;
+}
+
+} // namespace
+
+int main() {
+    const size_t BODY_COUNTS[] = {90, 900, 9000, 90000};
+    const int WARMUP_STEPS = 30;
+    const int CHECK_STEPS = 30;
+    const float DT = 1.0f / 120.0f;
+
+    std::printf("bodies,bytes,save_us,restore_us,deterministic\n");
+
+    for (size_t bodyCount : BODY_COUNTS) {
+        Engine::PhysicsEngine physics;
+        physics.SetDeterministic(true);
+        BuildScene(physics, bodyCount);
+        for (int i = 0; i < WARMUP_STEPS; ++i) {
+            physics.Update(DT);
+        }
+
+        // Assez de répétitions pour mesurer, sans dépasser ~1 s par taille
+        const int repeats = static_cast<int>(std::max<size_t>(5, 2000000 / (bodyCount + 1000)));
+        Engine::SnapshotBlob blob;
+        physics.SaveState(blob); // Capacité du tampon réservée une fois
+
+        auto start = Clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            physics.SaveState(blob);
+        }
+        double saveUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+
+        start = Clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            physics.LoadState(blob);
+        }
+        double restoreUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+
+        // Même trajectoire après restauration, au bit près
+        for (int i = 0; i < CHECK_STEPS; ++i) {
+            physics.Update(DT);
+        }
+        std::vector<float> reference = Positions(physics);
+        bool restored = physics.LoadState(blob);
+        for (int i = 0; i < CHECK_STEPS; ++i) {
+            physics.Update(DT);
+        }
+        std::vector<float> replay = Positions(physics);
+        bool deterministic = restored && reference.size() == replay.size() &&
+            std::memcmp(reference.data(), replay.data(), reference.size() * sizeof(float)) == 0;
+
+        std::printf("%zu,%zu,%.2f,%.2f,%d\n", physics.GetBodies().Size(), blob.size(),
+                    saveUs, restoreUs, deterministic ? 1 : 0);
+    }
+
+    return 0;
+}
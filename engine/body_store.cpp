@@ -0,0 +1,85 @@
+#include "body_store.h"
+#include <utility>
+
+namespace Engine {
+
+BodyHandle BodyStore::Create() {
+    uint32_t slot;
+    if (m_firstFree != FreeSlot) {
+        // Réutiliser un emplacement libre (la génération a déjà été avancée)
+        slot = m_firstFree;
+        m_firstFree = m_slots[slot].nextFree;
+    } else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    uint32_t dense = static_cast<uint32_t>(m_denseToSlot.size());
+    m_slots[slot].dense = dense;
+    m_slots[slot].nextFree = FreeSlot;
+    m_denseToSlot.push_back(slot);
+
+    ForEachArray([](auto& array) { array.emplace_back(); });
+
+    return {slot, m_slots[slot].generation};
+}
+
+void BodyStore::Destroy(BodyHandle handle) {
+    if (!IsAlive(handle)) return;
+
+    // Compaction : le dernier corps prend la place du corps détruit
+    uint32_t dense = m_slots[handle.index].dense;
+    uint32_t last = static_cast<uint32_t>(m_denseToSlot.size() - 1);
+    if (dense != last) {
+        ForEachArray([dense, last](auto& array) { array[dense] = array[last]; });
+        m_denseToSlot[dense] = m_denseToSlot[last];
+        m_slots[m_denseToSlot[dense]].dense = dense;
+    }
+    ForEachArray([](auto& array) { array.pop_back(); });
+    m_denseToSlot.pop_back();
+
+    // Libérer l'emplacement ; la nouvelle génération invalide les anciens handles
+    Slot& freed = m_slots[handle.index];
+    freed.dense = FreeSlot;
+    freed.generation++;
+    freed.nextFree = m_firstFree;
+    m_firstFree = handle.index;
+}
+
+void BodyStore::Swap(uint32_t a, uint32_t b) {
+    if (a == b) return;
+    ForEachArray([a, b](auto& array) { std::swap(array[a], array[b]); });
+    std::swap(m_denseToSlot[a], m_denseToSlot[b]);
+    m_slots[m_denseToSlot[a]].dense = a;
+    m_slots[m_denseToSlot[b]].dense = b;
+}
+
+void BodyStore::SaveState(SnapshotWriter& writer) const {
+    ForEachArray([&writer](const auto& array) { writer.WriteArray(array); });
+    writer.WriteArray(m_slots);
+    writer.WriteArray(m_denseToSlot);
+    writer.Write(m_firstFree);
+}
+
+bool BodyStore::LoadState(SnapshotReader& reader) {
+    ForEachArray([&reader](auto& array) { reader.ReadArray(array); });
+    reader.ReadArray(m_slots);
+    reader.ReadArray(m_denseToSlot);
+    reader.Read(m_firstFree);
+    return reader.IsValid();
+}
+
+void BodyStore::Clear() {
+    // Les emplacements sont conservés pour que les anciens handles restent invalides
+    for (uint32_t slot : m_denseToSlot) {
+        Slot& freed = m_slots[slot];
+        freed.dense = FreeSlot;
+        freed.generation++;
+        freed.nextFree = m_firstFree;
+        m_firstFree = slot;
+    }
+    ForEachArray([](auto& array) { array.clear(); });
+    m_denseToSlot.clear();
+}
+
+} // namespace Engine
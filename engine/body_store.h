@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <glm/glm.hpp>
+#include "snapshot.h"
+
+namespace Engine {
+
+// Allocateur aligné (AVX = 32 octets) pour les tableaux SoA
+template <typename T, size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count) {
+        size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* ptr = ::operator new(bytes, std::align_val_t(Alignment));
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t) {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Référence stable vers un corps : reste valide quand d'autres corps sont
+// détruits, et devient invalide (génération différente) quand le sien l'est
+struct BodyHandle {
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != InvalidIndex; }
+    bool operator==(const BodyHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const BodyHandle& other) const { return !(*this == other); }
+};
+
+// Drapeaux par corps
+enum BodyFlags : uint8_t {
+    BodyFlag_Kinematic  = 1 << 0, // Ne bouge pas avec la physique
+    BodyFlag_UseGravity = 1 << 1,
+    BodyFlag_Sleeping   = 1 << 2, // Îlot endormi : ni intégré ni testé
+    BodyFlag_Moved      = 1 << 3, // Cinématique déplacé depuis le dernier pas
+    BodyFlag_Static     = 1 << 4, // Géométrie fixe du niveau (cinématique, hors broadphase)
+    BodyFlag_Oriented   = 1 << 5, // Boîte orientée (SetOrientation) : box est son AABB englobante
+    BodyFlag_Frozen     = 1 << 6, // Îlot gelé par le LOD : ni intégré ni testé, immobile au contact
+    BodyFlag_Idle       = 1 << 7, // Créneau LOD qui n'avance pas pendant ce pas
+};
+
+// Au repos pendant ce pas : seul un corps actif peut le toucher
+constexpr uint8_t BodyFlag_Resting = BodyFlag_Sleeping | BodyFlag_Frozen | BodyFlag_Idle;
+
+// Stockage structure-of-arrays de tous les corps.
+// Les tableaux sont denses et compacts : une destruction déplace le dernier
+// corps dans le trou (O(1)), et la table d'indirection garde les handles valides.
+class BodyStore {
+public:
+    BodyHandle Create();
+    void Destroy(BodyHandle handle);
+    void Clear(); // Détruit tous les corps
+
+    // Échange deux entrées denses ; les handles restent valides
+    void Swap(uint32_t a, uint32_t b);
+
+    // Copie brute de tous les tableaux et de la table des handles
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+    bool IsAlive(BodyHandle handle) const {
+        return handle.index < m_slots.size() &&
+               m_slots[handle.index].generation == handle.generation &&
+               m_slots[handle.index].dense != FreeSlot;
+    }
+
+    // Indice dense (position dans les tableaux) d'un handle vivant
+    uint32_t DenseIndex(BodyHandle handle) const { return m_slots[handle.index].dense; }
+    BodyHandle HandleAt(uint32_t dense) const {
+        uint32_t slot = m_denseToSlot[dense];
+        return {slot, m_slots[slot].generation};
+    }
+
+    size_t Size() const { return m_denseToSlot.size(); }
+    size_t SlotCount() const { return m_slots.size(); }
+
+    // Accès vectoriel pratique (indice dense)
+    glm::vec3 Position(uint32_t i) const { return {posX[i], posY[i], posZ[i]}; }
+    glm::vec3 PreviousPosition(uint32_t i) const { return {prevPosX[i], prevPosY[i], prevPosZ[i]}; }
+    glm::vec3 Velocity(uint32_t i) const { return {velX[i], velY[i], velZ[i]}; }
+    glm::vec3 Force(uint32_t i) const { return {forceX[i], forceY[i], forceZ[i]}; }
+    glm::vec3 BoxMin(uint32_t i) const { return {boxMinX[i], boxMinY[i], boxMinZ[i]}; }
+    glm::vec3 BoxMax(uint32_t i) const { return {boxMaxX[i], boxMaxY[i], boxMaxZ[i]}; }
+    void SetPosition(uint32_t i, const glm::vec3& p) { posX[i] = p.x; posY[i] = p.y; posZ[i] = p.z; }
+    void SetPreviousPosition(uint32_t i, const glm::vec3& p) { prevPosX[i] = p.x; prevPosY[i] = p.y; prevPosZ[i] = p.z; }
+    void SetVelocity(uint32_t i, const glm::vec3& v) { velX[i] = v.x; velY[i] = v.y; velZ[i] = v.z; }
+    void SetForce(uint32_t i, const glm::vec3& f) { forceX[i] = f.x; forceY[i] = f.y; forceZ[i] = f.z; }
+    void SetBox(uint32_t i, const glm::vec3& mn, const glm::vec3& mx) {
+        boxMinX[i] = mn.x; boxMinY[i] = mn.y; boxMinZ[i] = mn.z;
+        boxMaxX[i] = mx.x; boxMaxY[i] = mx.y; boxMaxZ[i] = mx.z;
+    }
+    bool IsKinematic(uint32_t i) const { return (flags[i] & BodyFlag_Kinematic) != 0; }
+    bool IsSleeping(uint32_t i) const { return (flags[i] & BodyFlag_Sleeping) != 0; }
+    bool IsStatic(uint32_t i) const { return (flags[i] & BodyFlag_Static) != 0; }
+    bool IsFrozen(uint32_t i) const { return (flags[i] & BodyFlag_Frozen) != 0; }
+    bool IsResting(uint32_t i) const { return (flags[i] & BodyFlag_Resting) != 0; }
+
+    // Tableaux SoA (indexés par indice dense)
+    AlignedVector<float> posX, posY, posZ;
+    AlignedVector<float> prevPosX, prevPosY, prevPosZ; // Début du dernier pas (interpolation)
+    AlignedVector<float> velX, velY, velZ;
+    AlignedVector<float> forceX, forceY, forceZ;
+    AlignedVector<float> mass;
+    AlignedVector<float> friction, restitution;
+    AlignedVector<float> boxMinX, boxMinY, boxMinZ;
+    AlignedVector<float> boxMaxX, boxMaxY, boxMaxZ;
+    AlignedVector<float> groundY; // Hauteur du sol sous le corps au dernier pas
+    AlignedVector<uint32_t> collisionGroup; // 0 = aucun ; même groupe : pas de contact
+    AlignedVector<uint8_t> flags;
+    AlignedVector<uint8_t> lod; // Créneau LOD de l'îlot (PhysicsEngine), 0 = plein régime
+
+private:
+    static constexpr uint32_t FreeSlot = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense = FreeSlot;
+        uint32_t generation = 0;
+        uint32_t nextFree = FreeSlot;
+    };
+
+    template <typename Fn>
+    void ForEachArray(Fn&& fn) { ForEachArrayOf(*this, fn); }
+    template <typename Fn>
+    void ForEachArray(Fn&& fn) const { ForEachArrayOf(*this, fn); }
+
+    template <typename Self, typename Fn>
+    static void ForEachArrayOf(Self& self, Fn& fn) {
+        fn(self.posX); fn(self.posY); fn(self.posZ);
+        fn(self.prevPosX); fn(self.prevPosY); fn(self.prevPosZ);
+        fn(self.velX); fn(self.velY); fn(self.velZ);
+        fn(self.forceX); fn(self.forceY); fn(self.forceZ);
+        fn(self.mass);
+        fn(self.friction); fn(self.restitution);
+        fn(self.boxMinX); fn(self.boxMinY); fn(self.boxMinZ);
+        fn(self.boxMaxX); fn(self.boxMaxY); fn(self.boxMaxZ);
+        fn(self.groundY);
+        fn(self.collisionGroup);
+        fn(self.flags);
+        fn(self.lod);
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_denseToSlot;
+    uint32_t m_firstFree = FreeSlot;
+};
+
+} // namespace Engine
@@ -0,0 +1,266 @@
+#include "broadphase.h"
+#include <algorithm>
+
+namespace Engine {
+
+void SweepAndPrune::AddBody(BodyHandle body) {
+    if (body.index >= m_proxies.size()) {
+        m_proxies.resize(body.index + 1);
+    }
+    Proxy& proxy = m_proxies[body.index];
+    proxy = Proxy();
+    proxy.body = body;
+    proxy.active = true;
+    m_hasPending = true;
+}
+
+void SweepAndPrune::RemoveBody(BodyHandle body) {
+    if (body.index >= m_proxies.size()) return;
+    Proxy& proxy = m_proxies[body.index];
+    if (!proxy.active || proxy.body != body) return;
+    uint32_t id = body.index;
+
+    // Retirer les extrémités
+    m_endpoints.erase(
+        std::remove_if(m_endpoints.begin(), m_endpoints.end(),
+            [id](const Endpoint& e) { return e.proxy == id; }),
+        m_endpoints.end()
+    );
+
+    // Retirer les paires qui référencent ce corps
+    for (size_t i = 0; i < m_pairs.size();) {
+        if (m_pairs[i].bodyA == body || m_pairs[i].bodyB == body) {
+            uint64_t key = m_pairKeys[i];
+            RemovePair(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key));
+        } else {
+            ++i;
+        }
+    }
+
+    proxy = Proxy();
+}
+
+void SweepAndPrune::Clear() {
+    m_proxies.clear();
+    m_endpoints.clear();
+    m_pairs.clear();
+    m_pairKeys.clear();
+    m_pairIndex.Clear();
+    m_hasPending = false;
+}
+
+void SweepAndPrune::Update(const BodyStore& bodies, float margin) {
+    // Rafraîchir les intervalles Z depuis les corps
+    for (auto& proxy : m_proxies) {
+        if (!proxy.active) continue;
+        uint32_t i = bodies.DenseIndex(proxy.body);
+        proxy.minZ = bodies.posZ[i] + bodies.boxMinZ[i];
+        proxy.maxZ = bodies.posZ[i] + bodies.boxMaxZ[i] + margin;
+        proxy.isKinematic = bodies.IsKinematic(i);
+    }
+    for (auto& e : m_endpoints) {
+        const Proxy& proxy = m_proxies[e.proxy];
+        e.value = e.isMin ? proxy.minZ : proxy.maxZ;
+    }
+
+    InsertPending();
+    SortEndpoints();
+}
+
+void SweepAndPrune::InsertPending() {
+    if (!m_hasPending) return;
+    m_hasPending = false;
+
+    // Les nouveaux corps sont ajoutés en fin de liste : le tri par insertion
+    // les ramène à leur place et génère leurs paires au passage
+    for (uint32_t id = 0; id < m_proxies.size(); ++id) {
+        Proxy& proxy = m_proxies[id];
+        if (!proxy.active || proxy.inserted) continue;
+        proxy.inserted = true;
+        m_endpoints.push_back({proxy.minZ, id, true});
+        m_endpoints.push_back({proxy.maxZ, id, false});
+    }
+}
+
+void SweepAndPrune::SortEndpoints() {
+    // À valeur égale, un début précède une fin (contact = chevauchement,
+    // comme dans CheckCollision)
+    auto less = [](const Endpoint& a, const Endpoint& b) {
+        return a.value < b.value || (a.value == b.value && a.isMin && !b.isMin);
+    };
+
+    for (size_t i = 1; i < m_endpoints.size(); ++i) {
+        Endpoint current = m_endpoints[i];
+        size_t j = i;
+
+        while (j > 0 && less(current, m_endpoints[j - 1])) {
+            const Endpoint& other = m_endpoints[j - 1];
+
+            if (other.proxy != current.proxy) {
+                if (current.isMin && !other.isMin) {
+                    // Un début passe avant une fin : les intervalles se rencontrent
+                    if (m_proxies[current.proxy].maxZ >= m_proxies[other.proxy].minZ) {
+                        AddPair(current.proxy, other.proxy);
+                    }
+                } else if (!current.isMin && other.isMin) {
+                    // Une fin passe avant un début : les intervalles se séparent
+                    RemovePair(current.proxy, other.proxy);
+                }
+            }
+
+            m_endpoints[j] = other;
+            --j;
+        }
+        m_endpoints[j] = current;
+    }
+}
+
+void SweepAndPrune::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_proxies);
+    writer.WriteArray(m_endpoints);
+    writer.Write(m_hasPending);
+    writer.WriteArray(m_pairs);
+    writer.WriteArray(m_pairKeys);
+    m_pairIndex.SaveState(writer);
+}
+
+bool SweepAndPrune::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_proxies);
+    reader.ReadArray(m_endpoints);
+    reader.Read(m_hasPending);
+    reader.ReadArray(m_pairs);
+    reader.ReadArray(m_pairKeys);
+    m_pairIndex.LoadState(reader);
+    return reader.IsValid();
+}
+
+uint64_t SweepAndPrune::PairKey(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void SweepAndPrune::AddPair(uint32_t a, uint32_t b) {
+    // Deux corps cinématiques ne se résolvent jamais entre eux
+    if (m_proxies[a].isKinematic && m_proxies[b].isKinematic) return;
+
+    uint64_t key = PairKey(a, b);
+    if (m_pairIndex.Find(key) != PairIndex::NotFound) return;
+
+    // Ordre stable (plus petit proxy en premier) indépendant du sens de l'échange
+    if (a > b) std::swap(a, b);
+    m_pairIndex.Set(key, static_cast<uint32_t>(m_pairs.size()));
+    m_pairs.push_back({m_proxies[a].body, m_proxies[b].body});
+    m_pairKeys.push_back(key);
+}
+
+void SweepAndPrune::RemovePair(uint32_t a, uint32_t b) {
+    uint64_t key = PairKey(a, b);
+    uint32_t index = m_pairIndex.Find(key);
+    if (index == PairIndex::NotFound) return;
+
+    // Retrait par échange avec le dernier élément
+    uint32_t last = static_cast<uint32_t>(m_pairs.size() - 1);
+    if (index != last) {
+        m_pairs[index] = m_pairs[last];
+        m_pairKeys[index] = m_pairKeys[last];
+        m_pairIndex.Set(m_pairKeys[index], index);
+    }
+    m_pairs.pop_back();
+    m_pairKeys.pop_back();
+    m_pairIndex.Erase(key);
+}
+
+void PairIndex::Clear() {
+    // La capacité est gardée : vider la table à chaque pas n'alloue rien
+    std::fill(m_keys.begin(), m_keys.end(), EmptyKey);
+    m_count = 0;
+}
+
+uint32_t PairIndex::Find(uint64_t key) const {
+    if (m_keys.empty()) return NotFound;
+    const size_t mask = m_keys.size() - 1;
+    for (size_t i = Home(key);; i = (i + 1) & mask) {
+        if (m_keys[i] == key) return m_values[i];
+        if (m_keys[i] == EmptyKey) return NotFound;
+    }
+}
+
+void PairIndex::Set(uint64_t key, uint32_t value) {
+    // Charge maximale 1/2 : les sondes restent courtes
+    if ((m_count + 1) * 2 > m_keys.size()) {
+        Grow();
+    }
+
+    const size_t mask = m_keys.size() - 1;
+    size_t i = Home(key);
+    while (m_keys[i] != EmptyKey && m_keys[i] != key) {
+        i = (i + 1) & mask;
+    }
+    if (m_keys[i] == EmptyKey) {
+        m_keys[i] = key;
+        m_count++;
+    }
+    m_values[i] = value;
+}
+
+void PairIndex::Erase(uint64_t key) {
+    if (m_keys.empty()) return;
+    const size_t mask = m_keys.size() - 1;
+
+    size_t hole = Home(key);
+    while (m_keys[hole] != key) {
+        if (m_keys[hole] == EmptyKey) return;
+        hole = (hole + 1) & mask;
+    }
+
+    // Décalage arrière : ramener dans le trou les entrées dont la position
+    // d'origine précède le trou, pour ne jamais couper une chaîne de sondage
+    for (size_t i = (hole + 1) & mask; m_keys[i] != EmptyKey; i = (i + 1) & mask) {
+        size_t home = Home(m_keys[i]);
+        bool reachable = hole <= i ? (home <= hole || home > i) : (home <= hole && home > i);
+        if (reachable) {
+            m_keys[hole] = m_keys[i];
+            m_values[hole] = m_values[i];
+            hole = i;
+        }
+    }
+    m_keys[hole] = EmptyKey;
+    m_count--;
+}
+
+void PairIndex::Grow() {
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    keys.swap(m_keys);
+    values.swap(m_values);
+
+    size_t capacity = std::max<size_t>(64, keys.size() * 2);
+    m_keys.assign(capacity, EmptyKey);
+    m_values.assign(capacity, 0);
+    m_count = 0;
+    m_shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+        m_shift--;
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] != EmptyKey) Set(keys[i], values[i]);
+    }
+}
+
+void PairIndex::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_keys);
+    writer.WriteArray(m_values);
+    writer.Write(m_count);
+    writer.Write(m_shift);
+}
+
+bool PairIndex::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_keys);
+    reader.ReadArray(m_values);
+    reader.Read(m_count);
+    reader.Read(m_shift);
+    return reader.IsValid();
+}
+
+} // namespace Engine
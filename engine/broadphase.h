@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "body_store.h"
+#include "snapshot.h"
+
+namespace Engine {
+
+// Paire candidate produite par la broadphase
+struct BroadphasePair {
+    BodyHandle bodyA;
+    BodyHandle bodyB;
+};
+
+// Compteurs de la phase de collision (mis à jour à chaque Update)
+struct CollisionStats {
+    size_t bodyCount = 0;
+    size_t persistentPairs = 0; // Paires qui se chevauchent sur Z
+    size_t pairsTested = 0;     // Paires envoyées à CheckCollision
+    size_t pairsCulled = 0;     // Paires éliminées sans test
+    size_t staticBodies = 0;    // Formes de la géométrie statique (hors bodyCount)
+    size_t staticContacts = 0;  // Contacts trouvés dans la géométrie statique
+    size_t contacts = 0;        // Contacts résolus (corps-corps et statiques)
+    size_t warmStarted = 0;     // Contacts repris du pas précédent
+};
+
+// Index clé de paire -> position dans la liste de paires : table de hachage
+// à adressage ouvert (sondage linéaire, retrait par décalage arrière).
+// Deux tableaux plats, donc copiable tel quel dans un instantané.
+class PairIndex {
+public:
+    static constexpr uint32_t NotFound = 0xFFFFFFFFu;
+
+    void Clear();
+    uint32_t Find(uint64_t key) const;
+    void Set(uint64_t key, uint32_t value); // Insère ou remplace
+    void Erase(uint64_t key);
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    static constexpr uint64_t EmptyKey = ~0ull; // Jamais produite : InvalidIndex n'a pas de proxy
+
+    size_t Home(uint64_t key) const { return (key * 0x9E3779B97F4A7C15ull) >> m_shift; }
+    void Grow();
+
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_values;
+    size_t m_count = 0;
+    uint32_t m_shift = 64;
+};
+
+// Sweep-and-prune incrémental le long de Z (l'axe du parcours).
+// Les extrémités restent triées d'une frame à l'autre : un tri par insertion
+// sur une liste presque triée coûte O(n), et chaque échange d'extrémités
+// ajoute ou retire une paire de la liste persistante.
+class SweepAndPrune {
+public:
+    void AddBody(BodyHandle body);
+    void RemoveBody(BodyHandle body);
+    void Clear();
+
+    // Met à jour les intervalles Z et la liste de paires. Deux corps séparés
+    // de moins de margin sur Z forment encore une paire.
+    void Update(const BodyStore& bodies, float margin = 0.0f);
+
+    const std::vector<BroadphasePair>& GetPairs() const { return m_pairs; }
+
+    // Copie brute de l'état incrémental (l'ordre des paires est conservé)
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    // Un proxy par emplacement de handle (handle.index)
+    struct Proxy {
+        BodyHandle body;
+        float minZ = 0.0f;
+        float maxZ = 0.0f;
+        bool active = false;
+        bool inserted = false; // false tant que le corps attend sa première mise à jour
+        bool isKinematic = false;
+    };
+
+    struct Endpoint {
+        float value;
+        uint32_t proxy;
+        bool isMin;
+    };
+
+    void InsertPending();
+    void SortEndpoints();
+    void AddPair(uint32_t a, uint32_t b);
+    void RemovePair(uint32_t a, uint32_t b);
+    static uint64_t PairKey(uint32_t a, uint32_t b);
+
+    std::vector<Proxy> m_proxies;
+    std::vector<Endpoint> m_endpoints;
+    bool m_hasPending = false;
+
+    // Liste de paires persistante + index pour retrait O(1)
+    std::vector<BroadphasePair> m_pairs;
+    std::vector<uint64_t> m_pairKeys;
+    PairIndex m_pairIndex;
+};
+
+} // namespace Engine
@@ -0,0 +1,125 @@
+#include "contact_events.h"
+#include <algorithm>
+
+namespace Engine {
+
+void ContactEvents::Clear() {
+    m_events.clear();
+    m_ground.clear();
+    m_touching.clear();
+    m_next.clear();
+    m_seen.clear();
+    m_touchingIndex.Clear();
+}
+
+void ContactEvents::AddGround(const BodyStore& bodies, uint32_t i, const glm::vec3& normal, float impulse) {
+    ContactEvent contact;
+    contact.bodyB = bodies.HandleAt(i);
+    contact.normal = normal;
+    contact.point = glm::vec3(bodies.posX[i], bodies.groundY[i], bodies.posZ[i]);
+    contact.impulse = normal * impulse;
+    m_ground.push_back(contact);
+}
+
+void ContactEvents::Record(const BodyStore& bodies, const std::vector<Contact>& contacts) {
+    // Même capacité que m_touching (qui croît par push_back) : assign seul
+    // réallouerait à chaque contact de plus
+    m_seen.reserve(m_touching.capacity());
+    m_seen.assign(m_touching.size(), 0);
+    m_next.clear();
+
+    for (const Contact& solved : contacts) {
+        uint32_t a = solved.denseA;
+        uint32_t b = solved.denseB;
+        glm::vec3 low = glm::max(bodies.Position(a) + bodies.BoxMin(a), bodies.Position(b) + bodies.BoxMin(b));
+        glm::vec3 high = glm::min(bodies.Position(a) + bodies.BoxMax(a), bodies.Position(b) + bodies.BoxMax(b));
+
+        ContactEvent contact;
+        contact.bodyA = solved.bodyA;
+        contact.bodyB = solved.bodyB;
+        contact.normal = solved.normal;
+        contact.point = (low + high) * 0.5f;
+        contact.impulse = solved.impulse;
+        Track(contact);
+    }
+    for (ContactEvent& contact : m_ground) {
+        Track(contact);
+    }
+    m_ground.clear();
+
+    // Contacts du pas précédent absents de celui-ci
+    for (size_t k = 0; k < m_touching.size(); ++k) {
+        if (m_seen[k]) continue;
+        ContactEvent& contact = m_touching[k];
+        if (IsDormant(bodies, contact)) {
+            m_next.push_back(contact);
+            continue;
+        }
+        contact.type = ContactEventType::End;
+        contact.impulse = glm::vec3(0.0f);
+        m_events.push_back(contact);
+    }
+
+    m_touching.swap(m_next);
+    m_touchingIndex.Clear();
+    for (size_t k = 0; k < m_touching.size(); ++k) {
+        m_touchingIndex.Set(PairKey(m_touching[k].bodyA, m_touching[k].bodyB), static_cast<uint32_t>(k));
+    }
+}
+
+void ContactEvents::Track(ContactEvent& contact) {
+    // Même emplacement mais autre génération : l'ancien corps a été détruit
+    // entre-temps, ce contact-là se termine et celui-ci commence
+    uint32_t previous = m_touchingIndex.Find(PairKey(contact.bodyA, contact.bodyB));
+    bool persists = false;
+    if (previous != PairIndex::NotFound && !m_seen[previous]) {
+        const ContactEvent& old = m_touching[previous];
+        persists = (old.bodyA == contact.bodyA && old.bodyB == contact.bodyB) ||
+                   (old.bodyA == contact.bodyB && old.bodyB == contact.bodyA);
+        m_seen[previous] = persists;
+    }
+
+    contact.type = persists ? ContactEventType::Persist : ContactEventType::Begin;
+    m_events.push_back(contact);
+    m_next.push_back(contact);
+}
+
+bool ContactEvents::IsDormant(const BodyStore& bodies, const ContactEvent& contact) {
+    // Sans corps dynamique actif, la paire n'est plus testée : un corps
+    // endormi (ou gelé, ou hors de son créneau LOD) contre un autre au repos,
+    // un cinématique, la statique ou le sol
+    bool anyResting = false;
+    for (BodyHandle body : {contact.bodyA, contact.bodyB}) {
+        if (!body.IsValid()) continue; // Sol
+        if (!bodies.IsAlive(body)) return false;
+        uint32_t i = bodies.DenseIndex(body);
+        if (bodies.IsResting(i)) {
+            anyResting = true;
+        } else if (!bodies.IsKinematic(i)) {
+            return false;
+        }
+    }
+    return anyResting;
+}
+
+void ContactEvents::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_touching);
+    m_touchingIndex.SaveState(writer);
+}
+
+bool ContactEvents::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_touching);
+    m_touchingIndex.LoadState(reader);
+    m_events.clear();
+    m_ground.clear();
+    return reader.IsValid();
+}
+
+uint64_t ContactEvents::PairKey(BodyHandle a, BodyHandle b) {
+    // Le sol (index invalide) passe en second : la clé vide n'est jamais produite
+    uint32_t low = std::min(a.index, b.index);
+    uint32_t high = std::max(a.index, b.index);
+    return (static_cast<uint64_t>(low) << 32) | high;
+}
+
+} // namespace Engine
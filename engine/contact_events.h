@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "body_store.h"
+#include "broadphase.h"
+#include "contacts.h"
+#include "snapshot.h"
+
+namespace Engine {
+
+enum class ContactEventType : uint8_t {
+    Begin,   // Premier pas où les deux corps se touchent
+    Persist, // Toujours en contact (un événement par pas)
+    End      // Séparés, ou l'un des corps a été détruit
+};
+
+// Contact entre deux corps à moins de ContactSolver::Margin. bodyA est
+// invalide pour le sol (normale du terrain sous B, point à sa hauteur).
+struct ContactEvent {
+    ContactEventType type = ContactEventType::Begin;
+    BodyHandle bodyA;
+    BodyHandle bodyB;
+    glm::vec3 normal{0.0f};  // De A vers B
+    glm::vec3 point{0.0f};   // Centre de la zone de recouvrement des AABB
+    glm::vec3 impulse{0.0f}; // Appliquée à B pendant le pas (nulle pour End)
+};
+
+// Flux d'événements de contact : à chaque pas, les contacts du solveur et du
+// sol sont comparés à ceux du pas précédent (table de hachage par paire).
+// Les tableaux sont réutilisés d'un pas à l'autre : rien n'est alloué une fois
+// leur taille atteinte. Un contact dont les corps dorment (ou sont gelés, ou
+// attendent leur créneau LOD) n'est plus mesuré : il est gardé tel quel, sans
+// événement, jusqu'à leur réveil.
+class ContactEvents {
+public:
+    // Début d'un Update : les événements du précédent sont oubliés
+    void ClearEvents() { m_events.clear(); }
+    void Clear();
+
+    // Corps posé sur le sol (hauteur groundY[i]) pendant ce pas ; impulse
+    // le long de la normale
+    void AddGround(const BodyStore& bodies, uint32_t i, const glm::vec3& normal, float impulse);
+    // Fin du pas : Begin/Persist pour les contacts présents, End pour les autres
+    void Record(const BodyStore& bodies, const std::vector<Contact>& contacts);
+
+    const std::vector<ContactEvent>& GetEvents() const { return m_events; }
+    size_t GetTouchingCount() const { return m_touching.size(); }
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    static uint64_t PairKey(BodyHandle a, BodyHandle b);
+    static bool IsDormant(const BodyStore& bodies, const ContactEvent& contact);
+    void Track(ContactEvent& contact);
+
+    std::vector<ContactEvent> m_events;
+    std::vector<ContactEvent> m_ground;   // Contacts avec le sol du pas en cours
+    std::vector<ContactEvent> m_touching; // Contacts du pas précédent
+    std::vector<ContactEvent> m_next;
+    std::vector<uint8_t> m_seen;          // Contacts de m_touching retrouvés ce pas
+    PairIndex m_touchingIndex;
+};
+
+} // namespace Engine
@@ -0,0 +1,217 @@
+#include "contacts.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+namespace {
+
+const float RESTITUTION_SPEED = 0.5f; // En dessous, pas de rebond : le contact se pose
+const float PENETRATION_SLOP = 0.005f;
+const float PENETRATION_CORRECTION = 0.8f; // Part de la pénétration corrigée par pas
+
+} // namespace
+
+void ContactSolver::Begin() {
+    m_contacts.swap(m_previous);
+    m_contacts.clear();
+    m_warmStarted = 0;
+
+    m_previousIndex.Clear();
+    for (size_t k = 0; k < m_previous.size(); ++k) {
+        m_previousIndex.Set(PairKey(m_previous[k].bodyA, m_previous[k].bodyB), static_cast<uint32_t>(k));
+    }
+}
+
+void ContactSolver::Clear() {
+    m_contacts.clear();
+    m_previous.clear();
+    m_previousIndex.Clear();
+    m_warmStarted = 0;
+}
+
+bool ContactSolver::Add(const BodyStore& bodies, uint32_t a, uint32_t b) {
+    Contact contact;
+    if (!Measure(bodies, a, b, Margin, contact)) return false;
+    AddMeasured(contact);
+    return true;
+}
+
+void ContactSolver::AddMeasured(Contact contact) {
+    // Même paire, même normale qu'au pas précédent : reprendre son impulsion
+    uint32_t previous = m_previousIndex.Find(PairKey(contact.bodyA, contact.bodyB));
+    if (previous != PairIndex::NotFound) {
+        const Contact& old = m_previous[previous];
+        bool same = old.bodyA == contact.bodyA && old.bodyB == contact.bodyB;
+        bool swapped = old.bodyA == contact.bodyB && old.bodyB == contact.bodyA;
+        float sign = same ? 1.0f : -1.0f;
+        if ((same || swapped) && glm::dot(old.normal * sign, contact.normal) > 0.5f) {
+            contact.impulse = old.impulse * sign;
+            m_warmStarted++;
+        }
+    }
+
+    m_contacts.push_back(contact);
+}
+
+void ContactSolver::Prepare(BodyStore& bodies, float deltaTime) {
+    // Vitesses visées d'abord : le warm start d'un contact ne doit pas
+    // passer pour un choc sur le contact voisin
+    for (Contact& contact : m_contacts) {
+        PrepareContact(bodies, contact, deltaTime);
+    }
+
+    // Warm start : réappliquer les impulsions du pas précédent
+    for (const Contact& contact : m_contacts) {
+        if (contact.impulse == glm::vec3(0.0f)) continue;
+        bodies.SetVelocity(contact.denseA, bodies.Velocity(contact.denseA) - contact.impulse * contact.inverseMassA);
+        bodies.SetVelocity(contact.denseB, bodies.Velocity(contact.denseB) + contact.impulse * contact.inverseMassB);
+    }
+}
+
+void ContactSolver::Solve(BodyStore& bodies) {
+    for (Contact& contact : m_contacts) {
+        SolveContact(bodies, contact);
+    }
+}
+
+void ContactSolver::Correct(BodyStore& bodies) {
+    for (const Contact& contact : m_contacts) {
+        float inverseMassSum = contact.inverseMassA + contact.inverseMassB;
+        if (inverseMassSum <= 0.0f) continue;
+
+        float correction = std::max(contact.depth - PENETRATION_SLOP, 0.0f) *
+                           PENETRATION_CORRECTION / inverseMassSum;
+        if (correction <= 0.0f) continue;
+
+        glm::vec3 shift = contact.normal * correction;
+        bodies.SetPosition(contact.denseA, bodies.Position(contact.denseA) - shift * contact.inverseMassA);
+        bodies.SetPosition(contact.denseB, bodies.Position(contact.denseB) + shift * contact.inverseMassB);
+    }
+}
+
+bool ContactSolver::Measure(const BodyStore& bodies, uint32_t a, uint32_t b, float margin, Contact& contact) {
+    glm::vec3 minA = bodies.Position(a) + bodies.BoxMin(a);
+    glm::vec3 maxA = bodies.Position(a) + bodies.BoxMax(a);
+    glm::vec3 minB = bodies.Position(b) + bodies.BoxMin(b);
+    glm::vec3 maxB = bodies.Position(b) + bodies.BoxMax(b);
+
+    // Recouvrement par axe (négatif : écart entre les boîtes)
+    glm::vec3 overlap = glm::min(maxA, maxB) - glm::max(minA, minB);
+    if (overlap.x < -margin || overlap.y < -margin || overlap.z < -margin) return false;
+
+    int axis = overlap.x < overlap.y ? (overlap.x < overlap.z ? 0 : 2) : (overlap.y < overlap.z ? 1 : 2);
+    float centerDelta = (minB[axis] + maxB[axis]) - (minA[axis] + maxA[axis]);
+
+    contact.bodyA = bodies.HandleAt(a);
+    contact.bodyB = bodies.HandleAt(b);
+    contact.denseA = a;
+    contact.denseB = b;
+    contact.axis = axis;
+    contact.normal = glm::vec3(0.0f);
+    contact.normal[axis] = centerDelta < 0.0f ? -1.0f : 1.0f;
+    contact.depth = overlap[axis];
+    contact.impulse = glm::vec3(0.0f);
+    return true;
+}
+
+void ContactSolver::PrepareContact(const BodyStore& bodies, Contact& contact, float deltaTime) {
+    uint32_t a = contact.denseA;
+    uint32_t b = contact.denseB;
+    // Un corps gelé par le LOD est du décor fixe pour ceux qui le touchent
+    contact.inverseMassA = bodies.IsKinematic(a) || bodies.IsFrozen(a) ? 0.0f : 1.0f / bodies.mass[a];
+    contact.inverseMassB = bodies.IsKinematic(b) || bodies.IsFrozen(b) ? 0.0f : 1.0f / bodies.mass[b];
+    contact.friction = std::min(bodies.friction[a], bodies.friction[b]);
+
+    // Écart : les corps peuvent encore le combler pendant ce pas. Contact :
+    // rebond seulement pour un vrai choc, un contact au repos vise 0.
+    glm::vec3 relativeVel = (bodies.Velocity(b) - bodies.Velocity(a)) - contact.surfaceVelocity;
+    float velAlongNormal = glm::dot(relativeVel, contact.normal);
+    float restitution = std::min(bodies.restitution[a], bodies.restitution[b]);
+    if (contact.depth < 0.0f && deltaTime > 0.0f) {
+        contact.targetSpeed = contact.depth / deltaTime;
+    } else {
+        contact.targetSpeed = velAlongNormal < -RESTITUTION_SPEED ? -restitution * velAlongNormal : 0.0f;
+    }
+}
+
+void ContactSolver::SolveContact(BodyStore& bodies, Contact& contact) {
+    float inverseMassSum = contact.inverseMassA + contact.inverseMassB;
+    if (inverseMassSum <= 0.0f) return;
+
+    uint32_t a = contact.denseA;
+    uint32_t b = contact.denseB;
+    int axis = contact.axis;
+    if (axis < 0) {
+        SolveContactAlong(bodies, contact);
+        return;
+    }
+    float sign = contact.normal[axis];
+
+    // Normale : l'impulsion cumulée reste positive (les corps ne s'attirent pas)
+    glm::vec3 relativeVel = bodies.Velocity(b) - bodies.Velocity(a);
+    float velAlongNormal = relativeVel[axis] * sign;
+    float oldNormal = contact.impulse[axis] * sign;
+    float newNormal = std::max(oldNormal + (contact.targetSpeed - velAlongNormal) / inverseMassSum, 0.0f);
+    glm::vec3 delta(0.0f);
+    delta[axis] = (newNormal - oldNormal) * sign;
+
+    // Frottement sur les deux autres axes, borné par friction * impulsion normale
+    float maxFriction = contact.friction * newNormal;
+    for (int t = 1; t < 3; ++t) {
+        int tangent = (axis + t) % 3;
+        float oldTangent = contact.impulse[tangent];
+        float newTangent = std::clamp(oldTangent - relativeVel[tangent] / inverseMassSum, -maxFriction, maxFriction);
+        delta[tangent] = newTangent - oldTangent;
+    }
+
+    contact.impulse += delta;
+    bodies.SetVelocity(a, bodies.Velocity(a) - delta * contact.inverseMassA);
+    bodies.SetVelocity(b, bodies.Velocity(b) + delta * contact.inverseMassB);
+}
+
+void ContactSolver::SolveContactAlong(BodyStore& bodies, Contact& contact) {
+    float inverseMassSum = contact.inverseMassA + contact.inverseMassB;
+    uint32_t a = contact.denseA;
+    uint32_t b = contact.denseB;
+    const glm::vec3& normal = contact.normal;
+
+    // Même schéma que SolveContact, projeté sur la normale et son plan tangent
+    glm::vec3 relativeVel = (bodies.Velocity(b) - bodies.Velocity(a)) - contact.surfaceVelocity;
+    float velAlongNormal = glm::dot(relativeVel, normal);
+    float oldNormal = glm::dot(contact.impulse, normal);
+    float newNormal = std::max(oldNormal + (contact.targetSpeed - velAlongNormal) / inverseMassSum, 0.0f);
+
+    // Frottement : impulsion tangente bornée en norme par friction * impulsion normale
+    glm::vec3 oldTangent = contact.impulse - normal * oldNormal;
+    glm::vec3 newTangent = oldTangent - (relativeVel - normal * velAlongNormal) / inverseMassSum;
+    float maxFriction = contact.friction * newNormal;
+    float tangentLength = glm::length(newTangent);
+    if (tangentLength > maxFriction) {
+        newTangent *= tangentLength > 0.0f ? maxFriction / tangentLength : 0.0f;
+    }
+
+    glm::vec3 delta = normal * (newNormal - oldNormal) + (newTangent - oldTangent);
+    contact.impulse += delta;
+    bodies.SetVelocity(a, bodies.Velocity(a) - delta * contact.inverseMassA);
+    bodies.SetVelocity(b, bodies.Velocity(b) + delta * contact.inverseMassB);
+}
+
+void ContactSolver::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_contacts);
+    writer.Write(m_warmStarted);
+}
+
+bool ContactSolver::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_contacts);
+    reader.Read(m_warmStarted);
+    return reader.IsValid();
+}
+
+uint64_t ContactSolver::PairKey(BodyHandle a, BodyHandle b) {
+    uint32_t low = std::min(a.index, b.index);
+    uint32_t high = std::max(a.index, b.index);
+    return (static_cast<uint64_t>(low) << 32) | high;
+}
+
+} // namespace Engine
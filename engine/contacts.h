@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "body_store.h"
+#include "broadphase.h"
+#include "snapshot.h"
+
+namespace Engine {
+
+// Contact entre deux AABB qui se chevauchent (ou presque : depth < 0 est un
+// écart). La normale suit l'axe de moindre pénétration et va de A vers B.
+// Contre une boîte orientée (toujours A), la normale vient du SAT et axis vaut -1.
+struct Contact {
+    BodyHandle bodyA;
+    BodyHandle bodyB;
+    glm::vec3 normal{0.0f};
+    float depth = 0.0f;
+    glm::vec3 impulse{0.0f}; // Impulsion cumulée appliquée à B (normale + frottement)
+
+    // Préparé à chaque pas
+    uint32_t denseA = 0;
+    uint32_t denseB = 0;
+    float inverseMassA = 0.0f;
+    float inverseMassB = 0.0f;
+    float targetSpeed = 0.0f; // Vitesse normale visée (rebond)
+    float friction = 0.0f;
+    int axis = 0;             // Axe de la normale (-1 : normale quelconque)
+    glm::vec3 surfaceVelocity{0.0f}; // Vitesse de la surface de A en plus de la sienne (rotation)
+};
+
+// Contacts persistants : chaque pas, les contacts déjà présents au pas
+// précédent reprennent leur impulsion cumulée (warm start), puis le tout est
+// résolu par impulsions séquentielles. Un contact au repos converge ainsi en
+// quelques passes au lieu de repartir de zéro à chaque frame.
+// Les corps à moins de Margin l'un de l'autre gardent leur contact : il
+// les laisse se rapprocher sans rebond et conserve son impulsion.
+class ContactSolver {
+public:
+    static constexpr float Margin = 0.02f;
+
+    // Nouveau pas : les contacts courants deviennent la source du warm start
+    void Begin();
+    // Ajoute le contact (a, b) si leurs AABB sont à moins de Margin ; faux sinon
+    bool Add(const BodyStore& bodies, uint32_t a, uint32_t b);
+    // Contact déjà mesuré (boîte orientée) : seul le warm start reste à faire
+    void AddMeasured(Contact contact);
+    void Clear();
+
+    // Masses, rebond et warm start, puis une passe par appel à Solve
+    void Prepare(BodyStore& bodies, float deltaTime);
+    void Solve(BodyStore& bodies);
+    // Sort les corps de la pénétration restante (positions seulement, sans
+    // ajouter de vitesse)
+    void Correct(BodyStore& bodies);
+
+    const std::vector<Contact>& GetContacts() const { return m_contacts; }
+    size_t GetWarmStartedCount() const { return m_warmStarted; }
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+    // Contact isolé, sans cache (ResolveCollision)
+    static bool Measure(const BodyStore& bodies, uint32_t a, uint32_t b, float margin, Contact& contact);
+    static void PrepareContact(const BodyStore& bodies, Contact& contact, float deltaTime);
+    static void SolveContact(BodyStore& bodies, Contact& contact);
+
+private:
+    static uint64_t PairKey(BodyHandle a, BodyHandle b);
+    static void SolveContactAlong(BodyStore& bodies, Contact& contact);
+
+    std::vector<Contact> m_contacts;
+    std::vector<Contact> m_previous;
+    PairIndex m_previousIndex;
+    size_t m_warmStarted = 0;
+};
+
+} // namespace Engine
@@ -0,0 +1,188 @@
+#include "frame_capture.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace Engine {
+
+namespace {
+
+bool EndsWith(const std::string& text, const char* suffix) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    std::string end(suffix);
+    return lower.size() >= end.size() && lower.compare(lower.size() - end.size(), end.size(), end) == 0;
+}
+
+// RGB -> YCbCr BT.601 (plage vidéo 16-235), en entiers ; les décalages gardent
+// les sommes positives avant le >> 8
+inline uint8_t LumaOf(int r, int g, int b) {
+    return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+inline uint8_t BlueDiffOf(int r, int g, int b) {
+    return static_cast<uint8_t>((-38 * r - 74 * g + 112 * b + 128 + (128 << 8)) >> 8);
+}
+inline uint8_t RedDiffOf(int r, int g, int b) {
+    return static_cast<uint8_t>((112 * r - 94 * g - 18 * b + 128 + (128 << 8)) >> 8);
+}
+
+} // namespace
+
+bool CaptureFormatFromPath(const std::string& path, CaptureFormat& format) {
+    if (EndsWith(path, ".raw")) format = CaptureFormat::Raw;
+    else if (EndsWith(path, ".ppm")) format = CaptureFormat::Ppm;
+    else if (EndsWith(path, ".y4m")) format = CaptureFormat::Y4m;
+    else return false;
+    return true;
+}
+
+FrameWriter::~FrameWriter() {
+    Close();
+}
+
+bool FrameWriter::Open(const std::string& path, CaptureFormat format, int width, int height, int framesPerSecond) {
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        std::cerr << "Erreur: Impossible d'ouvrir " << path << " pour la capture" << std::endl;
+        return false;
+    }
+    m_format = format;
+    m_width = width;
+    m_height = height;
+    m_stop = false;
+    m_failed = false;
+    m_framesWritten = 0;
+
+    if (m_format == CaptureFormat::Y4m) {
+        std::fprintf(m_file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, framesPerSecond);
+    }
+
+    const size_t frameBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    m_pool.assign(PoolSize, std::vector<uint8_t>(frameBytes));
+    m_free.clear();
+    for (std::vector<uint8_t>& frame : m_pool) {
+        m_free.push_back(frame.data());
+    }
+    m_queue.clear();
+    m_scratch.resize(static_cast<size_t>(width) * static_cast<size_t>(height) * 3);
+
+    m_writer = std::thread(&FrameWriter::WriterLoop, this);
+    return true;
+}
+
+void FrameWriter::Close() {
+    if (!m_file) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_pool.clear();
+    m_free.clear();
+}
+
+uint8_t* FrameWriter::AcquireFrame() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_released.wait(lock, [this] { return !m_free.empty(); });
+    uint8_t* frame = m_free.back();
+    m_free.pop_back();
+    return frame;
+}
+
+void FrameWriter::SubmitFrame(uint8_t* frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(frame);
+    }
+    m_wake.notify_one();
+}
+
+uint64_t FrameWriter::GetFramesWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_framesWritten;
+}
+
+bool FrameWriter::HasFailed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+void FrameWriter::MarkFailed() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_failed = true;
+}
+
+void FrameWriter::WriterLoop() {
+    for (;;) {
+        uint8_t* frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // À l'arrêt, la file est vidée avant de sortir
+            m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            frame = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        WriteFrame(frame);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(frame);
+            m_framesWritten++;
+        }
+        m_released.notify_one();
+    }
+}
+
+void FrameWriter::WriteFrame(const uint8_t* rgba) {
+    const size_t width = static_cast<size_t>(m_width);
+    const size_t height = static_cast<size_t>(m_height);
+    const size_t pixels = width * height;
+    uint8_t* out = m_scratch.data();
+
+    // Lignes remises de haut en bas au passage
+    if (m_format == CaptureFormat::Y4m) {
+        uint8_t* luma = out;
+        uint8_t* blue = out + pixels;
+        uint8_t* red = out + 2 * pixels;
+        for (size_t y = 0; y < height; ++y) {
+            const uint8_t* row = rgba + (height - 1 - y) * width * 4;
+            for (size_t x = 0; x < width; ++x) {
+                int r = row[4 * x], g = row[4 * x + 1], b = row[4 * x + 2];
+                size_t i = y * width + x;
+                luma[i] = LumaOf(r, g, b);
+                blue[i] = BlueDiffOf(r, g, b);
+                red[i] = RedDiffOf(r, g, b);
+            }
+        }
+        std::fputs("FRAME\n", m_file);
+    } else {
+        for (size_t y = 0; y < height; ++y) {
+            const uint8_t* row = rgba + (height - 1 - y) * width * 4;
+            uint8_t* rgb = out + y * width * 3;
+            for (size_t x = 0; x < width; ++x) {
+                rgb[3 * x] = row[4 * x];
+                rgb[3 * x + 1] = row[4 * x + 1];
+                rgb[3 * x + 2] = row[4 * x + 2];
+            }
+        }
+        if (m_format == CaptureFormat::Ppm) {
+            std::fprintf(m_file, "P6\n%d %d\n255\n", m_width, m_height);
+        }
+    }
+
+    if (std::fwrite(out, 1, pixels * 3, m_file) != pixels * 3) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_failed = true;
+    }
+}
+
+} // namespace Engine
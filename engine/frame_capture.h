@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+
+// Format du fichier de capture
+enum class CaptureFormat {
+    Raw, // RGB 8 bits concaténés, sans en-tête
+    Ppm, // Suite d'images P6 (lisible par ffmpeg -f image2pipe -c:v ppm)
+    Y4m  // YUV4MPEG2 4:4:4, vidéo directement lisible
+};
+
+// Format d'après l'extension (.raw, .ppm, .y4m) ; false si inconnue
+bool CaptureFormatFromPath(const std::string& path, CaptureFormat& format);
+
+// Écrit des images RGBA (lignes de bas en haut, comme glReadPixels) dans un
+// fichier, sur un thread à part : conversion et écriture ne coûtent rien au
+// thread qui capture. Les tampons tournent dans un pool fixe ; s'il est vide,
+// AcquireFrame attend le writer (contre-pression plutôt que perte d'images).
+class FrameWriter {
+public:
+    FrameWriter() = default;
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    bool Open(const std::string& path, CaptureFormat format, int width, int height, int framesPerSecond);
+    // Écrit les images en attente puis ferme le fichier
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    // Tampon libre de width * height * 4 octets, à rendre par SubmitFrame
+    uint8_t* AcquireFrame();
+    void SubmitFrame(uint8_t* frame);
+
+    uint64_t GetFramesWritten() const;
+    bool HasFailed() const; // Une écriture a échoué (disque plein...)
+    // Une image n'a pas pu être relue : le fichier sera incomplet
+    void MarkFailed();
+
+private:
+    static constexpr size_t PoolSize = 4;
+
+    void WriterLoop();
+    void WriteFrame(const uint8_t* rgba);
+
+    std::FILE* m_file = nullptr;
+    CaptureFormat m_format = CaptureFormat::Raw;
+    int m_width = 0;
+    int m_height = 0;
+
+    std::vector<std::vector<uint8_t>> m_pool;
+    std::vector<uint8_t*> m_free;  // Tampons disponibles pour AcquireFrame
+    std::deque<uint8_t*> m_queue;  // Images à écrire, dans l'ordre
+    std::vector<uint8_t> m_scratch; // Ligne ou plans convertis (writer seulement)
+
+    std::thread m_writer;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;     // Writer : image en attente ou arrêt
+    std::condition_variable m_released; // Capture : tampon rendu au pool
+    bool m_stop = false;
+    bool m_failed = false;
+    uint64_t m_framesWritten = 0;
+};
+
+} // namespace Engine
@@ -0,0 +1,170 @@
+#include "frustum.h"
+#include "simd.h"
+#include <cmath>
+
+namespace Engine {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Chemin scalaire (référence et traitement des boîtes restantes)
+// ---------------------------------------------------------------------------
+
+bool BoxInside(const Frustum& frustum, float cx, float cy, float cz, float hx, float hy, float hz) {
+    for (int p = 0; p < Frustum::PlaneCount; ++p) {
+        float distance = ((frustum.normalX[p] * cx + frustum.normalY[p] * cy) + frustum.normalZ[p] * cz) + frustum.d[p];
+        float reach = (std::abs(frustum.normalX[p]) * hx + std::abs(frustum.normalY[p]) * hy) +
+                      std::abs(frustum.normalZ[p]) * hz;
+        if (distance + reach < 0.0f) return false;
+    }
+    return true;
+}
+
+void CullScalar(const Frustum& frustum, const AabbBatch& boxes, uint8_t* visible, size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+        visible[k] = BoxInside(frustum, boxes.centerX[k], boxes.centerY[k], boxes.centerZ[k],
+                               boxes.halfX[k], boxes.halfY[k], boxes.halfZ[k]) ? 1 : 0;
+    }
+}
+
+#if defined(WOBBLY_X86)
+
+// ---------------------------------------------------------------------------
+// SSE4.1 : 4 boîtes par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_SSE41
+size_t CullSSE41(const Frustum& frustum, const AabbBatch& boxes, uint8_t* visible, size_t count) {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 cx = _mm_loadu_ps(&boxes.centerX[k]);
+        __m128 cy = _mm_loadu_ps(&boxes.centerY[k]);
+        __m128 cz = _mm_loadu_ps(&boxes.centerZ[k]);
+        __m128 hx = _mm_loadu_ps(&boxes.halfX[k]);
+        __m128 hy = _mm_loadu_ps(&boxes.halfY[k]);
+        __m128 hz = _mm_loadu_ps(&boxes.halfZ[k]);
+
+        __m128 outside = zero;
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            __m128 nx = _mm_set1_ps(frustum.normalX[p]);
+            __m128 ny = _mm_set1_ps(frustum.normalY[p]);
+            __m128 nz = _mm_set1_ps(frustum.normalZ[p]);
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                                    _mm_mul_ps(nz, cz)),
+                                         _mm_set1_ps(frustum.d[p]));
+            __m128 reach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, nx), hx),
+                                                 _mm_mul_ps(_mm_andnot_ps(sign, ny), hy)),
+                                      _mm_mul_ps(_mm_andnot_ps(sign, nz), hz));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+        }
+
+        int mask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[k + lane] = (mask >> lane) & 1 ? 0 : 1;
+        }
+    }
+    return k;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 : 8 boîtes par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_AVX2
+size_t CullAVX2(const Frustum& frustum, const AabbBatch& boxes, uint8_t* visible, size_t count) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 cx = _mm256_loadu_ps(&boxes.centerX[k]);
+        __m256 cy = _mm256_loadu_ps(&boxes.centerY[k]);
+        __m256 cz = _mm256_loadu_ps(&boxes.centerZ[k]);
+        __m256 hx = _mm256_loadu_ps(&boxes.halfX[k]);
+        __m256 hy = _mm256_loadu_ps(&boxes.halfY[k]);
+        __m256 hz = _mm256_loadu_ps(&boxes.halfZ[k]);
+
+        __m256 outside = zero;
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            __m256 nx = _mm256_set1_ps(frustum.normalX[p]);
+            __m256 ny = _mm256_set1_ps(frustum.normalY[p]);
+            __m256 nz = _mm256_set1_ps(frustum.normalZ[p]);
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                                                          _mm256_mul_ps(nz, cz)),
+                                            _mm256_set1_ps(frustum.d[p]));
+            __m256 reach = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(sign, nx), hx),
+                                                       _mm256_mul_ps(_mm256_andnot_ps(sign, ny), hy)),
+                                         _mm256_mul_ps(_mm256_andnot_ps(sign, nz), hz));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), zero, _CMP_LT_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8; ++lane) {
+            visible[k + lane] = (mask >> lane) & 1 ? 0 : 1;
+        }
+    }
+    return k;
+}
+
+#endif // WOBBLY_X86
+
+} // namespace
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProjection) {
+    // Plans de Gribb-Hartmann : ligne 4 ± ligne i de la matrice
+    auto row = [&](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+    const glm::vec4 w = row(3);
+    const glm::vec4 planes[PlaneCount] = {
+        w + row(0), w - row(0), // Gauche, droite
+        w + row(1), w - row(1), // Bas, haut
+        w + row(2), w - row(2)  // Près, loin
+    };
+
+    Frustum frustum;
+    for (int p = 0; p < PlaneCount; ++p) {
+        float length = glm::length(glm::vec3(planes[p].x, planes[p].y, planes[p].z));
+        frustum.normalX[p] = planes[p].x / length;
+        frustum.normalY[p] = planes[p].y / length;
+        frustum.normalZ[p] = planes[p].z / length;
+        frustum.d[p] = planes[p].w / length;
+    }
+
+    // Coins : les sommets du cube NDC ramenés dans le monde
+    const glm::mat4 toWorld = glm::inverse(viewProjection);
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec4 ndc((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f, 1.0f);
+        glm::vec4 world = toWorld * ndc;
+        glm::vec3 point = glm::vec3(world.x, world.y, world.z) / world.w;
+        frustum.boundsMin = corner == 0 ? point : glm::min(frustum.boundsMin, point);
+        frustum.boundsMax = corner == 0 ? point : glm::max(frustum.boundsMax, point);
+    }
+    return frustum;
+}
+
+bool Frustum::IntersectsBox(const glm::vec3& center, const glm::vec3& halfExtents) const {
+    return BoxInside(*this, center.x, center.y, center.z, halfExtents.x, halfExtents.y, halfExtents.z);
+}
+
+void CullBoxes(const Frustum& frustum, const AabbBatch& boxes, uint8_t* visible, SimdLevel level) {
+    const size_t count = boxes.Size();
+    size_t done = 0;
+
+#if defined(WOBBLY_X86)
+    if (level == SimdLevel::AVX2) {
+        done = CullAVX2(frustum, boxes, visible, count);
+    } else if (level == SimdLevel::SSE41) {
+        done = CullSSE41(frustum, boxes, visible, count);
+    }
+#else
+    (void)level;
+#endif
+
+    CullScalar(frustum, boxes, visible, done, count);
+}
+
+} // namespace Engine
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "integrator.h"
+#include "oriented_box.h"
+
+namespace Engine {
+
+// Volume vu par une caméra : six plans tournés vers l'intérieur et l'AABB de
+// ses huit coins (pour borner une recherche avant le test des plans)
+struct Frustum {
+    static constexpr int PlaneCount = 6;
+
+    // viewProjection : projection * vue, conventions OpenGL (NDC dans [-1, 1])
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+    // Faux seulement si la boîte est entièrement derrière un plan : test
+    // conservateur, une boîte près d'un coin peut passer sans être visible
+    bool IntersectsBox(const glm::vec3& center, const glm::vec3& halfExtents) const;
+
+    // Plan k : dot(normal, p) + d >= 0 à l'intérieur, normale unitaire
+    float normalX[PlaneCount], normalY[PlaneCount], normalZ[PlaneCount], d[PlaneCount];
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+};
+
+// visible[k] = IntersectsBox pour chaque AABB du lot. Les chemins SIMD donnent
+// exactement les résultats du scalaire.
+void CullBoxes(const Frustum& frustum, const AabbBatch& boxes, uint8_t* visible, SimdLevel level);
+
+} // namespace Engine
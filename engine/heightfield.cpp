@@ -0,0 +1,151 @@
+#include "heightfield.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+namespace {
+
+const uint32_t MAX_CAST_STEPS = 4096; // Rayons très longs : pas plus grossier
+const int CAST_REFINE_STEPS = 20;
+
+} // namespace
+
+Heightfield::Heightfield() {
+    Reset(0.0f, 0.0f, 1.0f, 2, 2, 0.0f);
+}
+
+void Heightfield::Reset(float originX, float originZ, float cellSize, uint32_t columns, uint32_t rows, float height) {
+    m_originX = originX;
+    m_originZ = originZ;
+    m_cellSize = cellSize > 0.0f ? cellSize : 1.0f;
+    m_inverseCell = 1.0f / m_cellSize;
+    m_columns = std::max<uint32_t>(columns, 2);
+    m_rows = std::max<uint32_t>(rows, 2);
+    m_heights.assign(static_cast<size_t>(m_columns) * m_rows, height);
+    m_flat = true;
+}
+
+void Heightfield::Cover(float minX, float minZ, float maxX, float maxZ, float height) {
+    // Nombre entier de cellules ajoutées de chaque côté : les échantillons
+    // existants gardent leur position
+    auto cellsBefore = [this](float from, float origin) {
+        return from < origin ? static_cast<uint32_t>(std::ceil((origin - from) * m_inverseCell)) : 0u;
+    };
+    auto cellsAfter = [this](float to, float origin, uint32_t count) {
+        float last = origin + static_cast<float>(count - 1) * m_cellSize;
+        return to > last ? static_cast<uint32_t>(std::ceil((to - last) * m_inverseCell)) : 0u;
+    };
+    uint32_t left = cellsBefore(minX, m_originX);
+    uint32_t right = cellsAfter(maxX, m_originX, m_columns);
+    uint32_t front = cellsBefore(minZ, m_originZ);
+    uint32_t back = cellsAfter(maxZ, m_originZ, m_rows);
+    if (left == 0 && right == 0 && front == 0 && back == 0) return;
+
+    uint32_t columns = m_columns + left + right;
+    uint32_t rows = m_rows + front + back;
+    std::vector<float> heights(static_cast<size_t>(columns) * rows, height);
+    for (uint32_t row = 0; row < m_rows; ++row) {
+        std::copy_n(&m_heights[static_cast<size_t>(row) * m_columns], m_columns,
+                    &heights[static_cast<size_t>(row + front) * columns + left]);
+    }
+
+    m_originX -= static_cast<float>(left) * m_cellSize;
+    m_originZ -= static_cast<float>(front) * m_cellSize;
+    m_columns = columns;
+    m_rows = rows;
+    m_heights.swap(heights);
+    UpdateFlat();
+}
+
+void Heightfield::SetHeight(uint32_t column, uint32_t row, float height) {
+    float& sample = m_heights[static_cast<size_t>(row) * m_columns + column];
+    if (sample == height) return;
+    sample = height;
+    UpdateFlat();
+}
+
+uint32_t Heightfield::ColumnAt(float x) const {
+    float f = std::round((x - m_originX) * m_inverseCell);
+    return static_cast<uint32_t>(std::clamp(f, 0.0f, static_cast<float>(m_columns - 1)));
+}
+
+uint32_t Heightfield::RowAt(float z) const {
+    float f = std::round((z - m_originZ) * m_inverseCell);
+    return static_cast<uint32_t>(std::clamp(f, 0.0f, static_cast<float>(m_rows - 1)));
+}
+
+void Heightfield::UpdateFlat() {
+    m_flat = std::all_of(m_heights.begin(), m_heights.end(), [this](float h) { return h == m_heights[0]; });
+}
+
+bool Heightfield::Cast(const glm::vec3& origin, const glm::vec3& delta, float halfHeight, float maxT, float& t) const {
+    const float bottom = origin.y - halfHeight;
+    float horizontal = std::sqrt(delta.x * delta.x + delta.z * delta.z) * maxT;
+
+    // Sol plat, ou déplacement vertical : la hauteur ne change pas le long du segment
+    if (m_flat || horizontal == 0.0f) {
+        float ground = m_flat ? m_heights[0] : HeightAt(origin.x, origin.z);
+        float groundT = -1.0f;
+        if (bottom < ground) {
+            groundT = 0.0f;
+        } else if (delta.y < 0.0f) {
+            groundT = (bottom - ground) / -delta.y;
+        }
+        if (groundT < 0.0f || groundT > maxT) return false;
+        t = groundT;
+        return true;
+    }
+
+    auto below = [&](float s) {
+        return bottom + delta.y * s < HeightAt(origin.x + delta.x * s, origin.z + delta.z * s);
+    };
+    if (below(0.0f)) {
+        t = 0.0f;
+        return true;
+    }
+
+    uint32_t steps = static_cast<uint32_t>(std::ceil(horizontal * 2.0f * m_inverseCell));
+    steps = std::clamp<uint32_t>(steps, 1, MAX_CAST_STEPS);
+    float previous = 0.0f;
+    for (uint32_t k = 1; k <= steps; ++k) {
+        float current = maxT * static_cast<float>(k) / static_cast<float>(steps);
+        if (!below(current)) {
+            previous = current;
+            continue;
+        }
+        for (int i = 0; i < CAST_REFINE_STEPS; ++i) {
+            float middle = (previous + current) * 0.5f;
+            (below(middle) ? current : previous) = middle;
+        }
+        t = current;
+        return true;
+    }
+    return false;
+}
+
+void Heightfield::SaveState(SnapshotWriter& writer) const {
+    writer.Write(m_originX);
+    writer.Write(m_originZ);
+    writer.Write(m_cellSize);
+    writer.Write(m_inverseCell);
+    writer.Write(m_columns);
+    writer.Write(m_rows);
+    writer.WriteArray(m_heights);
+    writer.Write(m_flat);
+}
+
+bool Heightfield::LoadState(SnapshotReader& reader) {
+    reader.Read(m_originX);
+    reader.Read(m_originZ);
+    reader.Read(m_cellSize);
+    reader.Read(m_inverseCell);
+    reader.Read(m_columns);
+    reader.Read(m_rows);
+    reader.ReadArray(m_heights);
+    reader.Read(m_flat);
+    return reader.IsValid() && m_columns >= 2 && m_rows >= 2 &&
+           m_heights.size() == static_cast<size_t>(m_columns) * m_rows;
+}
+
+} // namespace Engine
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <glm/glm.hpp>
+#include "snapshot.h"
+
+namespace Engine {
+
+// Hauteur et normale du sol en un point
+struct TerrainSample {
+    float height = 0.0f;
+    glm::vec3 normal{0.0f, 1.0f, 0.0f};
+};
+
+// Sol en grille de hauteurs : columns x rows échantillons espacés de
+// cellSize, le premier en (originX, originZ), rangés ligne par ligne (une
+// ligne par z). Entre les échantillons, interpolation bilinéaire ; hors de la
+// grille, le bord le plus proche continue à plat. Par défaut, sol plat y = 0.
+class Heightfield {
+public:
+    Heightfield();
+
+    // Grille remplie de height (au moins 2 x 2 échantillons)
+    void Reset(float originX, float originZ, float cellSize, uint32_t columns, uint32_t rows, float height = 0.0f);
+    // Agrandit la grille (même pas, mêmes échantillons) pour couvrir le
+    // rectangle [minX, maxX] x [minZ, maxZ] ; les nouveaux échantillons valent height
+    void Cover(float minX, float minZ, float maxX, float maxZ, float height);
+
+    float GetHeight(uint32_t column, uint32_t row) const { return m_heights[row * m_columns + column]; }
+    void SetHeight(uint32_t column, uint32_t row, float height);
+
+    // Échantillon le plus proche de x (ou z), borné à la grille
+    uint32_t ColumnAt(float x) const;
+    uint32_t RowAt(float z) const;
+
+    float GetOriginX() const { return m_originX; }
+    float GetOriginZ() const { return m_originZ; }
+    float GetCellSize() const { return m_cellSize; }
+    float GetInverseCellSize() const { return m_inverseCell; }
+    uint32_t GetColumns() const { return m_columns; }
+    uint32_t GetRows() const { return m_rows; }
+    const float* GetHeights() const { return m_heights.data(); }
+    bool IsFlat() const { return m_flat; }
+
+    // O(1) : quatre échantillons. Les noyaux SIMD (CollideTerrainBatch)
+    // refont exactement ces opérations, dans le même ordre.
+    TerrainSample Sample(float x, float z) const {
+        const float maxX = static_cast<float>(m_columns - 1);
+        const float maxZ = static_cast<float>(m_rows - 1);
+        float rawX = (x - m_originX) * m_inverseCell;
+        float rawZ = (z - m_originZ) * m_inverseCell;
+        // Écrit comme _mm_max_ps / _mm_min_ps (NaN -> bord)
+        float fx = rawX > 0.0f ? rawX : 0.0f;
+        float fz = rawZ > 0.0f ? rawZ : 0.0f;
+        fx = fx < maxX ? fx : maxX;
+        fz = fz < maxZ ? fz : maxZ;
+
+        int32_t cx = static_cast<int32_t>(fx);
+        int32_t cz = static_cast<int32_t>(fz);
+        cx = cx < static_cast<int32_t>(m_columns) - 2 ? cx : static_cast<int32_t>(m_columns) - 2;
+        cz = cz < static_cast<int32_t>(m_rows) - 2 ? cz : static_cast<int32_t>(m_rows) - 2;
+        float tx = fx - static_cast<float>(cx);
+        float tz = fz - static_cast<float>(cz);
+
+        const float* cell = &m_heights[static_cast<size_t>(cz) * m_columns + static_cast<size_t>(cx)];
+        float h00 = cell[0];
+        float h10 = cell[1];
+        float h01 = cell[m_columns];
+        float h11 = cell[m_columns + 1];
+
+        float edge0 = h10 - h00;
+        float edge1 = h11 - h01;
+        float nearRow = h00 + edge0 * tx;
+        float farRow = h01 + edge1 * tx;
+
+        // Pentes de la surface bilinéaire ; nulles hors de la grille (bord à plat)
+        float slopeX = (edge0 + (edge1 - edge0) * tz) * m_inverseCell;
+        float side0 = h01 - h00;
+        float side1 = h11 - h10;
+        float slopeZ = (side0 + (side1 - side0) * tx) * m_inverseCell;
+        if (rawX < 0.0f || rawX > maxX) slopeX = 0.0f;
+        if (rawZ < 0.0f || rawZ > maxZ) slopeZ = 0.0f;
+
+        float length = std::sqrt(slopeX * slopeX + 1.0f + slopeZ * slopeZ);
+        TerrainSample sample;
+        sample.height = nearRow + (farRow - nearRow) * tz;
+        sample.normal = glm::vec3(-slopeX / length, 1.0f / length, -slopeZ / length);
+        return sample;
+    }
+    float HeightAt(float x, float z) const { return Sample(x, z).height; }
+    glm::vec3 NormalAt(float x, float z) const { return Sample(x, z).normal; }
+
+    // Point bas d'une boîte (centre origin, demi-hauteur halfHeight) déplacée
+    // de t * delta, t dans [0, maxT] : premier t où il passe sous le sol.
+    // Sol plat : exact ; sinon pas d'une demi-cellule puis dichotomie.
+    bool Cast(const glm::vec3& origin, const glm::vec3& delta, float halfHeight, float maxT, float& t) const;
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    void UpdateFlat();
+
+    float m_originX = 0.0f;
+    float m_originZ = 0.0f;
+    float m_cellSize = 1.0f;
+    float m_inverseCell = 1.0f;
+    uint32_t m_columns = 0;
+    uint32_t m_rows = 0;
+    std::vector<float> m_heights;
+    bool m_flat = true; // Tous les échantillons égaux : Cast analytique
+};
+
+} // namespace Engine
@@ -0,0 +1,531 @@
+#include "integrator.h"
+#include "simd.h"
+#include <cmath>
+#include <cstring>
+
+namespace Engine {
+
+namespace {
+
+constexpr float GROUND_EPSILON = 0.01f;     // Tolérance du test "au sol"
+constexpr float GROUND_FRICTION_SCALE = 10.0f;
+constexpr float TERRAIN_REST_SPEED = 0.1f;  // Rebond plus lent : annulé
+
+// ---------------------------------------------------------------------------
+// Chemin scalaire (référence et traitement des corps restants)
+// ---------------------------------------------------------------------------
+
+void IntegrateForcesScalar(BodyStore& b, const glm::vec3& g, float dt, float damping, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        float mass = b.mass[i];
+        if ((b.flags[i] & BodyFlag_Kinematic) || mass <= 0.0f) continue;
+
+        float fx = b.forceX[i];
+        float fy = b.forceY[i];
+        float fz = b.forceZ[i];
+
+        // Ajouter la gravité
+        if (b.flags[i] & BodyFlag_UseGravity) {
+            fx = fx + g.x * mass;
+            fy = fy + g.y * mass;
+            fz = fz + g.z * mass;
+        }
+
+        // a = F / m, puis v += a * dt
+        b.velX[i] = (b.velX[i] + (fx / mass) * dt) * damping;
+        b.velY[i] = (b.velY[i] + (fy / mass) * dt) * damping;
+        b.velZ[i] = (b.velZ[i] + (fz / mass) * dt) * damping;
+    }
+}
+
+void IntegrateVelocityScalar(BodyStore& b, float dt, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (b.flags[i] & BodyFlag_Kinematic) continue;
+
+        b.posX[i] = b.posX[i] + b.velX[i] * dt;
+        b.posY[i] = b.posY[i] + b.velY[i] * dt;
+        b.posZ[i] = b.posZ[i] + b.velZ[i] * dt;
+
+        // Friction au sol (simple) : le bas de la boîte touche le sol
+        if (b.posY[i] + b.boxMinY[i] <= b.groundY[i] + GROUND_EPSILON) {
+            float damping = 1.0f - b.friction[i] * dt * GROUND_FRICTION_SCALE;
+            b.velX[i] = b.velX[i] * damping;
+            b.velZ[i] = b.velZ[i] * damping;
+        }
+    }
+}
+
+void CollideTerrainScalar(BodyStore& b, const Heightfield& terrain, float* speedChange, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (b.flags[i] & BodyFlag_Kinematic) continue;
+
+        // Le sol sous le centre de la boîte
+        TerrainSample ground = terrain.Sample(b.posX[i], b.posZ[i]);
+        const glm::vec3& n = ground.normal;
+        b.groundY[i] = ground.height;
+        speedChange[i] = 0.0f;
+        if (!(b.posY[i] + b.boxMinY[i] < ground.height)) continue;
+
+        b.posY[i] = ground.height - b.boxMinY[i];
+
+        // Rebond sur la composante normale, arrêté si trop lent
+        float vn = (b.velX[i] * n.x + b.velY[i] * n.y) + b.velZ[i] * n.z;
+        if (!(vn < 0.0f)) continue;
+        float bounced = -vn * b.restitution[i];
+        if (std::abs(bounced) < TERRAIN_REST_SPEED) bounced = 0.0f;
+
+        b.velX[i] = (b.velX[i] - n.x * vn) + n.x * bounced;
+        b.velY[i] = (b.velY[i] - n.y * vn) + n.y * bounced;
+        b.velZ[i] = (b.velZ[i] - n.z * vn) + n.z * bounced;
+        speedChange[i] = bounced - vn;
+    }
+}
+
+#if defined(WOBBLY_X86)
+
+// ---------------------------------------------------------------------------
+// SSE4.1 : 4 corps par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_SSE41
+size_t IntegrateForcesSSE41(BodyStore& b, const glm::vec3& g, float dt, float airDamping, size_t begin,
+                            size_t end) {
+    const __m128 gx = _mm_set1_ps(g.x);
+    const __m128 gy = _mm_set1_ps(g.y);
+    const __m128 gz = _mm_set1_ps(g.z);
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 damping = _mm_set1_ps(airDamping);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 mass = _mm_loadu_ps(&b.mass[i]);
+        __m128 kinematic = LoadFlagMaskSSE(&b.flags[i], BodyFlag_Kinematic);
+        __m128 gravity = LoadFlagMaskSSE(&b.flags[i], BodyFlag_UseGravity);
+        __m128 active = _mm_andnot_ps(kinematic, _mm_cmpgt_ps(mass, zero));
+
+        __m128 fx = _mm_loadu_ps(&b.forceX[i]);
+        __m128 fy = _mm_loadu_ps(&b.forceY[i]);
+        __m128 fz = _mm_loadu_ps(&b.forceZ[i]);
+        fx = _mm_blendv_ps(fx, _mm_add_ps(fx, _mm_mul_ps(gx, mass)), gravity);
+        fy = _mm_blendv_ps(fy, _mm_add_ps(fy, _mm_mul_ps(gy, mass)), gravity);
+        fz = _mm_blendv_ps(fz, _mm_add_ps(fz, _mm_mul_ps(gz, mass)), gravity);
+
+        __m128 vx = _mm_loadu_ps(&b.velX[i]);
+        __m128 vy = _mm_loadu_ps(&b.velY[i]);
+        __m128 vz = _mm_loadu_ps(&b.velZ[i]);
+        __m128 nx = _mm_mul_ps(_mm_add_ps(vx, _mm_mul_ps(_mm_div_ps(fx, mass), vdt)), damping);
+        __m128 ny = _mm_mul_ps(_mm_add_ps(vy, _mm_mul_ps(_mm_div_ps(fy, mass), vdt)), damping);
+        __m128 nz = _mm_mul_ps(_mm_add_ps(vz, _mm_mul_ps(_mm_div_ps(fz, mass), vdt)), damping);
+
+        _mm_storeu_ps(&b.velX[i], _mm_blendv_ps(vx, nx, active));
+        _mm_storeu_ps(&b.velY[i], _mm_blendv_ps(vy, ny, active));
+        _mm_storeu_ps(&b.velZ[i], _mm_blendv_ps(vz, nz, active));
+    }
+    return i;
+}
+
+WOBBLY_TARGET_SSE41
+size_t IntegrateVelocitySSE41(BodyStore& b, float dt, size_t begin, size_t end) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 epsilon = _mm_set1_ps(GROUND_EPSILON);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(GROUND_FRICTION_SCALE);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 kinematic = LoadFlagMaskSSE(&b.flags[i], BodyFlag_Kinematic);
+
+        __m128 vx = _mm_loadu_ps(&b.velX[i]);
+        __m128 vy = _mm_loadu_ps(&b.velY[i]);
+        __m128 vz = _mm_loadu_ps(&b.velZ[i]);
+        __m128 px = _mm_loadu_ps(&b.posX[i]);
+        __m128 py = _mm_loadu_ps(&b.posY[i]);
+        __m128 pz = _mm_loadu_ps(&b.posZ[i]);
+
+        __m128 nx = _mm_add_ps(px, _mm_mul_ps(vx, vdt));
+        __m128 ny = _mm_add_ps(py, _mm_mul_ps(vy, vdt));
+        __m128 nz = _mm_add_ps(pz, _mm_mul_ps(vz, vdt));
+
+        // Friction au sol sur les corps actifs qui touchent le sol
+        __m128 bottom = _mm_add_ps(ny, _mm_loadu_ps(&b.boxMinY[i]));
+        __m128 contact = _mm_add_ps(_mm_loadu_ps(&b.groundY[i]), epsilon);
+        __m128 grounded = _mm_andnot_ps(kinematic, _mm_cmple_ps(bottom, contact));
+        __m128 friction = _mm_loadu_ps(&b.friction[i]);
+        __m128 factor = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(friction, vdt), scale));
+
+        _mm_storeu_ps(&b.posX[i], _mm_blendv_ps(nx, px, kinematic));
+        _mm_storeu_ps(&b.posY[i], _mm_blendv_ps(ny, py, kinematic));
+        _mm_storeu_ps(&b.posZ[i], _mm_blendv_ps(nz, pz, kinematic));
+        _mm_storeu_ps(&b.velX[i], _mm_blendv_ps(vx, _mm_mul_ps(vx, factor), grounded));
+        _mm_storeu_ps(&b.velZ[i], _mm_blendv_ps(vz, _mm_mul_ps(vz, factor), grounded));
+    }
+    return i;
+}
+
+// Sol (TerrainSample) sous 4 corps : 4 x 4 hauteurs chargées une à une
+WOBBLY_TARGET_SSE41
+size_t CollideTerrainSSE41(BodyStore& b, const Heightfield& terrain, float* speedChange, size_t begin, size_t end) {
+    const float* heights = terrain.GetHeights();
+    const int32_t columns = static_cast<int32_t>(terrain.GetColumns());
+    const __m128 originX = _mm_set1_ps(terrain.GetOriginX());
+    const __m128 originZ = _mm_set1_ps(terrain.GetOriginZ());
+    const __m128 inverseCell = _mm_set1_ps(terrain.GetInverseCellSize());
+    const __m128 maxX = _mm_set1_ps(static_cast<float>(terrain.GetColumns() - 1));
+    const __m128 maxZ = _mm_set1_ps(static_cast<float>(terrain.GetRows() - 1));
+    const __m128i lastCellX = _mm_set1_epi32(columns - 2);
+    const __m128i lastCellZ = _mm_set1_epi32(static_cast<int32_t>(terrain.GetRows()) - 2);
+    const __m128i stride = _mm_set1_epi32(columns);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 restSpeed = _mm_set1_ps(TERRAIN_REST_SPEED);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 active = _mm_xor_ps(LoadFlagMaskSSE(&b.flags[i], BodyFlag_Kinematic), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        __m128 px = _mm_loadu_ps(&b.posX[i]);
+        __m128 pz = _mm_loadu_ps(&b.posZ[i]);
+
+        __m128 rawX = _mm_mul_ps(_mm_sub_ps(px, originX), inverseCell);
+        __m128 rawZ = _mm_mul_ps(_mm_sub_ps(pz, originZ), inverseCell);
+        __m128 fx = _mm_min_ps(_mm_max_ps(rawX, zero), maxX);
+        __m128 fz = _mm_min_ps(_mm_max_ps(rawZ, zero), maxZ);
+        __m128i cx = _mm_min_epi32(_mm_cvttps_epi32(fx), lastCellX);
+        __m128i cz = _mm_min_epi32(_mm_cvttps_epi32(fz), lastCellZ);
+        __m128 tx = _mm_sub_ps(fx, _mm_cvtepi32_ps(cx));
+        __m128 tz = _mm_sub_ps(fz, _mm_cvtepi32_ps(cz));
+
+        alignas(16) int32_t cell[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(cell), _mm_add_epi32(_mm_mullo_epi32(cz, stride), cx));
+        const float* c0 = heights + cell[0];
+        const float* c1 = heights + cell[1];
+        const float* c2 = heights + cell[2];
+        const float* c3 = heights + cell[3];
+        __m128 h00 = _mm_setr_ps(c0[0], c1[0], c2[0], c3[0]);
+        __m128 h10 = _mm_setr_ps(c0[1], c1[1], c2[1], c3[1]);
+        __m128 h01 = _mm_setr_ps(c0[columns], c1[columns], c2[columns], c3[columns]);
+        __m128 h11 = _mm_setr_ps(c0[columns + 1], c1[columns + 1], c2[columns + 1], c3[columns + 1]);
+
+        __m128 edge0 = _mm_sub_ps(h10, h00);
+        __m128 edge1 = _mm_sub_ps(h11, h01);
+        __m128 nearRow = _mm_add_ps(h00, _mm_mul_ps(edge0, tx));
+        __m128 farRow = _mm_add_ps(h01, _mm_mul_ps(edge1, tx));
+        __m128 height = _mm_add_ps(nearRow, _mm_mul_ps(_mm_sub_ps(farRow, nearRow), tz));
+
+        __m128 slopeX = _mm_mul_ps(_mm_add_ps(edge0, _mm_mul_ps(_mm_sub_ps(edge1, edge0), tz)), inverseCell);
+        __m128 side0 = _mm_sub_ps(h01, h00);
+        __m128 side1 = _mm_sub_ps(h11, h10);
+        __m128 slopeZ = _mm_mul_ps(_mm_add_ps(side0, _mm_mul_ps(_mm_sub_ps(side1, side0), tx)), inverseCell);
+        slopeX = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(rawX, zero), _mm_cmpgt_ps(rawX, maxX)), slopeX);
+        slopeZ = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(rawZ, zero), _mm_cmpgt_ps(rawZ, maxZ)), slopeZ);
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(slopeX, slopeX), one), _mm_mul_ps(slopeZ, slopeZ)));
+        __m128 nx = _mm_div_ps(_mm_xor_ps(slopeX, sign), length);
+        __m128 ny = _mm_div_ps(one, length);
+        __m128 nz = _mm_div_ps(_mm_xor_ps(slopeZ, sign), length);
+
+        __m128 py = _mm_loadu_ps(&b.posY[i]);
+        __m128 boxMinY = _mm_loadu_ps(&b.boxMinY[i]);
+        __m128 below = _mm_and_ps(active, _mm_cmplt_ps(_mm_add_ps(py, boxMinY), height));
+
+        __m128 vx = _mm_loadu_ps(&b.velX[i]);
+        __m128 vy = _mm_loadu_ps(&b.velY[i]);
+        __m128 vz = _mm_loadu_ps(&b.velZ[i]);
+        __m128 vn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, nx), _mm_mul_ps(vy, ny)), _mm_mul_ps(vz, nz));
+        __m128 bounce = _mm_and_ps(below, _mm_cmplt_ps(vn, zero));
+        __m128 bounced = _mm_mul_ps(_mm_xor_ps(vn, sign), _mm_loadu_ps(&b.restitution[i]));
+        bounced = _mm_andnot_ps(_mm_cmplt_ps(_mm_andnot_ps(sign, bounced), restSpeed), bounced);
+
+        __m128 nvx = _mm_add_ps(_mm_sub_ps(vx, _mm_mul_ps(nx, vn)), _mm_mul_ps(nx, bounced));
+        __m128 nvy = _mm_add_ps(_mm_sub_ps(vy, _mm_mul_ps(ny, vn)), _mm_mul_ps(ny, bounced));
+        __m128 nvz = _mm_add_ps(_mm_sub_ps(vz, _mm_mul_ps(nz, vn)), _mm_mul_ps(nz, bounced));
+
+        _mm_storeu_ps(&b.groundY[i], _mm_blendv_ps(_mm_loadu_ps(&b.groundY[i]), height, active));
+        _mm_storeu_ps(&b.posY[i], _mm_blendv_ps(py, _mm_sub_ps(height, boxMinY), below));
+        _mm_storeu_ps(&b.velX[i], _mm_blendv_ps(vx, nvx, bounce));
+        _mm_storeu_ps(&b.velY[i], _mm_blendv_ps(vy, nvy, bounce));
+        _mm_storeu_ps(&b.velZ[i], _mm_blendv_ps(vz, nvz, bounce));
+        __m128 previous = _mm_loadu_ps(&speedChange[i]);
+        __m128 change = _mm_and_ps(bounce, _mm_sub_ps(bounced, vn));
+        _mm_storeu_ps(&speedChange[i], _mm_blendv_ps(previous, change, active));
+    }
+    return i;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 : 8 corps par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_AVX2
+size_t IntegrateForcesAVX2(BodyStore& b, const glm::vec3& g, float dt, float airDamping, size_t begin,
+                           size_t end) {
+    const __m256 gx = _mm256_set1_ps(g.x);
+    const __m256 gy = _mm256_set1_ps(g.y);
+    const __m256 gz = _mm256_set1_ps(g.z);
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 damping = _mm256_set1_ps(airDamping);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 mass = _mm256_loadu_ps(&b.mass[i]);
+        __m256 kinematic = LoadFlagMaskAVX2(&b.flags[i], BodyFlag_Kinematic);
+        __m256 gravity = LoadFlagMaskAVX2(&b.flags[i], BodyFlag_UseGravity);
+        __m256 active = _mm256_andnot_ps(kinematic, _mm256_cmp_ps(mass, zero, _CMP_GT_OQ));
+
+        __m256 fx = _mm256_loadu_ps(&b.forceX[i]);
+        __m256 fy = _mm256_loadu_ps(&b.forceY[i]);
+        __m256 fz = _mm256_loadu_ps(&b.forceZ[i]);
+        fx = _mm256_blendv_ps(fx, _mm256_add_ps(fx, _mm256_mul_ps(gx, mass)), gravity);
+        fy = _mm256_blendv_ps(fy, _mm256_add_ps(fy, _mm256_mul_ps(gy, mass)), gravity);
+        fz = _mm256_blendv_ps(fz, _mm256_add_ps(fz, _mm256_mul_ps(gz, mass)), gravity);
+
+        __m256 vx = _mm256_loadu_ps(&b.velX[i]);
+        __m256 vy = _mm256_loadu_ps(&b.velY[i]);
+        __m256 vz = _mm256_loadu_ps(&b.velZ[i]);
+        __m256 nx = _mm256_mul_ps(_mm256_add_ps(vx, _mm256_mul_ps(_mm256_div_ps(fx, mass), vdt)), damping);
+        __m256 ny = _mm256_mul_ps(_mm256_add_ps(vy, _mm256_mul_ps(_mm256_div_ps(fy, mass), vdt)), damping);
+        __m256 nz = _mm256_mul_ps(_mm256_add_ps(vz, _mm256_mul_ps(_mm256_div_ps(fz, mass), vdt)), damping);
+
+        _mm256_storeu_ps(&b.velX[i], _mm256_blendv_ps(vx, nx, active));
+        _mm256_storeu_ps(&b.velY[i], _mm256_blendv_ps(vy, ny, active));
+        _mm256_storeu_ps(&b.velZ[i], _mm256_blendv_ps(vz, nz, active));
+    }
+    return i;
+}
+
+WOBBLY_TARGET_AVX2
+size_t IntegrateVelocityAVX2(BodyStore& b, float dt, size_t begin, size_t end) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 epsilon = _mm256_set1_ps(GROUND_EPSILON);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(GROUND_FRICTION_SCALE);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 kinematic = LoadFlagMaskAVX2(&b.flags[i], BodyFlag_Kinematic);
+
+        __m256 vx = _mm256_loadu_ps(&b.velX[i]);
+        __m256 vy = _mm256_loadu_ps(&b.velY[i]);
+        __m256 vz = _mm256_loadu_ps(&b.velZ[i]);
+        __m256 px = _mm256_loadu_ps(&b.posX[i]);
+        __m256 py = _mm256_loadu_ps(&b.posY[i]);
+        __m256 pz = _mm256_loadu_ps(&b.posZ[i]);
+
+        __m256 nx = _mm256_add_ps(px, _mm256_mul_ps(vx, vdt));
+        __m256 ny = _mm256_add_ps(py, _mm256_mul_ps(vy, vdt));
+        __m256 nz = _mm256_add_ps(pz, _mm256_mul_ps(vz, vdt));
+
+        // Friction au sol sur les corps actifs qui touchent le sol
+        __m256 bottom = _mm256_add_ps(ny, _mm256_loadu_ps(&b.boxMinY[i]));
+        __m256 contact = _mm256_add_ps(_mm256_loadu_ps(&b.groundY[i]), epsilon);
+        __m256 grounded = _mm256_andnot_ps(kinematic, _mm256_cmp_ps(bottom, contact, _CMP_LE_OQ));
+        __m256 friction = _mm256_loadu_ps(&b.friction[i]);
+        __m256 factor = _mm256_sub_ps(one, _mm256_mul_ps(_mm256_mul_ps(friction, vdt), scale));
+
+        _mm256_storeu_ps(&b.posX[i], _mm256_blendv_ps(nx, px, kinematic));
+        _mm256_storeu_ps(&b.posY[i], _mm256_blendv_ps(ny, py, kinematic));
+        _mm256_storeu_ps(&b.posZ[i], _mm256_blendv_ps(nz, pz, kinematic));
+        _mm256_storeu_ps(&b.velX[i], _mm256_blendv_ps(vx, _mm256_mul_ps(vx, factor), grounded));
+        _mm256_storeu_ps(&b.velZ[i], _mm256_blendv_ps(vz, _mm256_mul_ps(vz, factor), grounded));
+    }
+    return i;
+}
+
+WOBBLY_TARGET_AVX2
+size_t CollideTerrainAVX2(BodyStore& b, const Heightfield& terrain, float* speedChange, size_t begin, size_t end) {
+    const float* heights = terrain.GetHeights();
+    const int32_t columns = static_cast<int32_t>(terrain.GetColumns());
+    const __m256 originX = _mm256_set1_ps(terrain.GetOriginX());
+    const __m256 originZ = _mm256_set1_ps(terrain.GetOriginZ());
+    const __m256 inverseCell = _mm256_set1_ps(terrain.GetInverseCellSize());
+    const __m256 maxX = _mm256_set1_ps(static_cast<float>(terrain.GetColumns() - 1));
+    const __m256 maxZ = _mm256_set1_ps(static_cast<float>(terrain.GetRows() - 1));
+    const __m256i lastCellX = _mm256_set1_epi32(columns - 2);
+    const __m256i lastCellZ = _mm256_set1_epi32(static_cast<int32_t>(terrain.GetRows()) - 2);
+    const __m256i stride = _mm256_set1_epi32(columns);
+    const __m256i right = _mm256_set1_epi32(1);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 restSpeed = _mm256_set1_ps(TERRAIN_REST_SPEED);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 active = _mm256_xor_ps(LoadFlagMaskAVX2(&b.flags[i], BodyFlag_Kinematic),
+                                      _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+        __m256 px = _mm256_loadu_ps(&b.posX[i]);
+        __m256 pz = _mm256_loadu_ps(&b.posZ[i]);
+
+        __m256 rawX = _mm256_mul_ps(_mm256_sub_ps(px, originX), inverseCell);
+        __m256 rawZ = _mm256_mul_ps(_mm256_sub_ps(pz, originZ), inverseCell);
+        __m256 fx = _mm256_min_ps(_mm256_max_ps(rawX, zero), maxX);
+        __m256 fz = _mm256_min_ps(_mm256_max_ps(rawZ, zero), maxZ);
+        __m256i cx = _mm256_min_epi32(_mm256_cvttps_epi32(fx), lastCellX);
+        __m256i cz = _mm256_min_epi32(_mm256_cvttps_epi32(fz), lastCellZ);
+        __m256 tx = _mm256_sub_ps(fx, _mm256_cvtepi32_ps(cx));
+        __m256 tz = _mm256_sub_ps(fz, _mm256_cvtepi32_ps(cz));
+
+        __m256i cell = _mm256_add_epi32(_mm256_mullo_epi32(cz, stride), cx);
+        __m256i farCell = _mm256_add_epi32(cell, stride);
+        __m256 h00 = _mm256_i32gather_ps(heights, cell, 4);
+        __m256 h10 = _mm256_i32gather_ps(heights, _mm256_add_epi32(cell, right), 4);
+        __m256 h01 = _mm256_i32gather_ps(heights, farCell, 4);
+        __m256 h11 = _mm256_i32gather_ps(heights, _mm256_add_epi32(farCell, right), 4);
+
+        __m256 edge0 = _mm256_sub_ps(h10, h00);
+        __m256 edge1 = _mm256_sub_ps(h11, h01);
+        __m256 nearRow = _mm256_add_ps(h00, _mm256_mul_ps(edge0, tx));
+        __m256 farRow = _mm256_add_ps(h01, _mm256_mul_ps(edge1, tx));
+        __m256 height = _mm256_add_ps(nearRow, _mm256_mul_ps(_mm256_sub_ps(farRow, nearRow), tz));
+
+        __m256 slopeX = _mm256_mul_ps(_mm256_add_ps(edge0, _mm256_mul_ps(_mm256_sub_ps(edge1, edge0), tz)), inverseCell);
+        __m256 side0 = _mm256_sub_ps(h01, h00);
+        __m256 side1 = _mm256_sub_ps(h11, h10);
+        __m256 slopeZ = _mm256_mul_ps(_mm256_add_ps(side0, _mm256_mul_ps(_mm256_sub_ps(side1, side0), tx)), inverseCell);
+        slopeX = _mm256_andnot_ps(_mm256_or_ps(_mm256_cmp_ps(rawX, zero, _CMP_LT_OQ),
+                                               _mm256_cmp_ps(rawX, maxX, _CMP_GT_OQ)), slopeX);
+        slopeZ = _mm256_andnot_ps(_mm256_or_ps(_mm256_cmp_ps(rawZ, zero, _CMP_LT_OQ),
+                                               _mm256_cmp_ps(rawZ, maxZ, _CMP_GT_OQ)), slopeZ);
+
+        __m256 length = _mm256_sqrt_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(slopeX, slopeX), one), _mm256_mul_ps(slopeZ, slopeZ)));
+        __m256 nx = _mm256_div_ps(_mm256_xor_ps(slopeX, sign), length);
+        __m256 ny = _mm256_div_ps(one, length);
+        __m256 nz = _mm256_div_ps(_mm256_xor_ps(slopeZ, sign), length);
+
+        __m256 py = _mm256_loadu_ps(&b.posY[i]);
+        __m256 boxMinY = _mm256_loadu_ps(&b.boxMinY[i]);
+        __m256 below = _mm256_and_ps(active, _mm256_cmp_ps(_mm256_add_ps(py, boxMinY), height, _CMP_LT_OQ));
+
+        __m256 vx = _mm256_loadu_ps(&b.velX[i]);
+        __m256 vy = _mm256_loadu_ps(&b.velY[i]);
+        __m256 vz = _mm256_loadu_ps(&b.velZ[i]);
+        __m256 vn = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, nx), _mm256_mul_ps(vy, ny)), _mm256_mul_ps(vz, nz));
+        __m256 bounce = _mm256_and_ps(below, _mm256_cmp_ps(vn, zero, _CMP_LT_OQ));
+        __m256 bounced = _mm256_mul_ps(_mm256_xor_ps(vn, sign), _mm256_loadu_ps(&b.restitution[i]));
+        bounced = _mm256_andnot_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, bounced), restSpeed, _CMP_LT_OQ), bounced);
+
+        __m256 nvx = _mm256_add_ps(_mm256_sub_ps(vx, _mm256_mul_ps(nx, vn)), _mm256_mul_ps(nx, bounced));
+        __m256 nvy = _mm256_add_ps(_mm256_sub_ps(vy, _mm256_mul_ps(ny, vn)), _mm256_mul_ps(ny, bounced));
+        __m256 nvz = _mm256_add_ps(_mm256_sub_ps(vz, _mm256_mul_ps(nz, vn)), _mm256_mul_ps(nz, bounced));
+
+        _mm256_storeu_ps(&b.groundY[i], _mm256_blendv_ps(_mm256_loadu_ps(&b.groundY[i]), height, active));
+        _mm256_storeu_ps(&b.posY[i], _mm256_blendv_ps(py, _mm256_sub_ps(height, boxMinY), below));
+        _mm256_storeu_ps(&b.velX[i], _mm256_blendv_ps(vx, nvx, bounce));
+        _mm256_storeu_ps(&b.velY[i], _mm256_blendv_ps(vy, nvy, bounce));
+        _mm256_storeu_ps(&b.velZ[i], _mm256_blendv_ps(vz, nvz, bounce));
+        __m256 previous = _mm256_loadu_ps(&speedChange[i]);
+        __m256 change = _mm256_and_ps(bounce, _mm256_sub_ps(bounced, vn));
+        _mm256_storeu_ps(&speedChange[i], _mm256_blendv_ps(previous, change, active));
+    }
+    return i;
+}
+
+#endif // WOBBLY_X86
+
+} // namespace
+
+SimdLevel DetectSimdLevel() {
+#if defined(WOBBLY_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+#elif defined(WOBBLY_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return SimdLevel::AVX2;
+    }
+    if (sse41) return SimdLevel::SSE41;
+#endif
+    return SimdLevel::Scalar;
+}
+
+const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE41: return "SSE4.1";
+        default: return "Scalar";
+    }
+}
+
+ScopedFloatEnvironment::ScopedFloatEnvironment(bool enabled) {
+#if defined(WOBBLY_X86)
+    if (!enabled) return;
+    // Valeur de démarrage : toutes les exceptions masquées, arrondi au plus proche
+    const unsigned int DEFAULT_MXCSR = 0x1F80;
+    m_saved = _mm_getcsr();
+    m_enabled = true;
+    _mm_setcsr(DEFAULT_MXCSR);
+#else
+    (void)enabled;
+#endif
+}
+
+ScopedFloatEnvironment::~ScopedFloatEnvironment() {
+#if defined(WOBBLY_X86)
+    if (m_enabled) {
+        _mm_setcsr(m_saved);
+    }
+#endif
+}
+
+void IntegrateForcesBatch(BodyStore& bodies, size_t begin, size_t end, const glm::vec3& gravity, float deltaTime,
+                          SimdLevel level, float damping) {
+    size_t done = begin;
+
+#if defined(WOBBLY_X86)
+    if (level == SimdLevel::AVX2) {
+        done = IntegrateForcesAVX2(bodies, gravity, deltaTime, damping, begin, end);
+    } else if (level == SimdLevel::SSE41) {
+        done = IntegrateForcesSSE41(bodies, gravity, deltaTime, damping, begin, end);
+    }
+#else
+    (void)level;
+#endif
+
+    IntegrateForcesScalar(bodies, gravity, deltaTime, damping, done, end);
+}
+
+void IntegrateVelocityBatch(BodyStore& bodies, size_t begin, size_t end, float deltaTime, SimdLevel level) {
+    size_t done = begin;
+
+#if defined(WOBBLY_X86)
+    if (level == SimdLevel::AVX2) {
+        done = IntegrateVelocityAVX2(bodies, deltaTime, begin, end);
+    } else if (level == SimdLevel::SSE41) {
+        done = IntegrateVelocitySSE41(bodies, deltaTime, begin, end);
+    }
+#else
+    (void)level;
+#endif
+
+    IntegrateVelocityScalar(bodies, deltaTime, done, end);
+}
+
+void CollideTerrainBatch(BodyStore& bodies, size_t begin, size_t end, const Heightfield& terrain,
+                         float* speedChange, SimdLevel level) {
+    size_t done = begin;
+
+#if defined(WOBBLY_X86)
+    if (level == SimdLevel::AVX2) {
+        done = CollideTerrainAVX2(bodies, terrain, speedChange, begin, end);
+    } else if (level == SimdLevel::SSE41) {
+        done = CollideTerrainSSE41(bodies, terrain, speedChange, begin, end);
+    }
+#else
+    (void)level;
+#endif
+
+    CollideTerrainScalar(bodies, terrain, speedChange, done, end);
+}
+
+} // namespace Engine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "body_store.h"
+#include "heightfield.h"
+
+namespace Engine {
+
+// Jeu d'instructions utilisé par les noyaux d'intégration
+enum class SimdLevel {
+    Scalar,
+    SSE41, // 4 corps par instruction
+    AVX2   // 8 corps par instruction
+};
+
+// Meilleur niveau supporté par le CPU courant (détection à l'exécution)
+SimdLevel DetectSimdLevel();
+const char* SimdLevelName(SimdLevel level);
+
+// Environnement flottant canonique (arrondi au plus proche, sans FTZ/DAZ)
+// le temps de la portée. Une bibliothèque compilée en -ffast-math ou un
+// pilote peut changer MXCSR dans le processus ; sans effet hors x86.
+class ScopedFloatEnvironment {
+public:
+    explicit ScopedFloatEnvironment(bool enabled);
+    ~ScopedFloatEnvironment();
+
+    ScopedFloatEnvironment(const ScopedFloatEnvironment&) = delete;
+    ScopedFloatEnvironment& operator=(const ScopedFloatEnvironment&) = delete;
+
+private:
+    unsigned int m_saved = 0;
+    bool m_enabled = false;
+};
+
+// Noyaux d'intégration sur les tableaux SoA du BodyStore.
+// Les chemins SIMD donnent exactement les mêmes résultats que le chemin
+// scalaire : mêmes opérations, dans le même ordre, sans FMA.
+
+// Seuls les corps d'indices denses [begin, end) sont traités.
+
+// Friction aérienne simple, appliquée à chaque appel de IntegrateForcesBatch
+constexpr float AIR_DAMPING = 0.995f;
+
+// v = (v + (F + g*m) / m * dt) * amortissement, pour les corps non cinématiques de masse > 0
+void IntegrateForcesBatch(BodyStore& bodies, size_t begin, size_t end, const glm::vec3& gravity, float deltaTime,
+                          SimdLevel level, float damping = AIR_DAMPING);
+
+// p += v * dt, puis friction sur x/z des corps non cinématiques posés sur groundY
+void IntegrateVelocityBatch(BodyStore& bodies, size_t begin, size_t end, float deltaTime, SimdLevel level);
+
+// Sol sous le centre de chaque corps non cinématique, rangé dans groundY ;
+// un corps qui s'y enfonce y est replacé et rebondit sur la normale.
+// speedChange[i] : variation de vitesse le long de la normale (0 sans rebond).
+void CollideTerrainBatch(BodyStore& bodies, size_t begin, size_t end, const Heightfield& terrain,
+                         float* speedChange, SimdLevel level);
+
+} // namespace Engine
@@ -0,0 +1,210 @@
+#include "islands.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Engine {
+
+uint32_t IslandManager::Find(uint32_t slot) {
+    // Compression de chemin par division
+    while (m_parent[slot] != slot) {
+        m_parent[slot] = m_parent[m_parent[slot]];
+        slot = m_parent[slot];
+    }
+    return slot;
+}
+
+void IslandManager::Build(BodyStore& bodies, const std::vector<Link>& links) {
+    const size_t slotCount = bodies.SlotCount();
+    const uint32_t bodyCount = static_cast<uint32_t>(bodies.Size());
+
+    m_parent.resize(slotCount);
+    std::iota(m_parent.begin(), m_parent.end(), 0u);
+
+    for (const Link& link : links) {
+        if (!bodies.IsAlive(link.first) || !bodies.IsAlive(link.second)) continue;
+        if (bodies.IsKinematic(bodies.DenseIndex(link.first)) ||
+            bodies.IsKinematic(bodies.DenseIndex(link.second))) continue;
+
+        uint32_t a = Find(link.first.index);
+        uint32_t b = Find(link.second.index);
+        if (a != b) m_parent[std::max(a, b)] = std::min(a, b);
+    }
+
+    // Numéroter les îlots, puis ranger leurs membres de façon contiguë
+    std::vector<uint32_t> rootIsland(slotCount, NoIsland);
+    m_islandOf.assign(slotCount, NoIsland);
+    m_offsets.assign(1, 0);
+
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        if (bodies.IsKinematic(i)) continue;
+        BodyHandle handle = bodies.HandleAt(i);
+        uint32_t root = Find(handle.index);
+        if (rootIsland[root] == NoIsland) {
+            rootIsland[root] = static_cast<uint32_t>(m_offsets.size() - 1);
+            m_offsets.push_back(0);
+        }
+        m_islandOf[handle.index] = rootIsland[root];
+        m_offsets[rootIsland[root] + 1]++;
+    }
+
+    const uint32_t islandCount = static_cast<uint32_t>(m_offsets.size() - 1);
+    for (uint32_t k = 0; k < islandCount; ++k) {
+        m_offsets[k + 1] += m_offsets[k];
+    }
+
+    m_members.resize(m_offsets.back());
+    m_anchors.resize(m_offsets.back());
+    std::vector<uint32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        if (bodies.IsKinematic(i)) continue;
+        BodyHandle handle = bodies.HandleAt(i);
+        m_members[cursor[m_islandOf[handle.index]]++] = handle;
+    }
+
+    // Un îlot ne reste endormi que si aucun de ses corps n'a été réveillé
+    // ou ajouté depuis
+    m_quietSteps.assign(islandCount, 0);
+    m_peakSpeeds.assign(islandCount, 0.0f);
+    m_sleeping.assign(islandCount, 0);
+    m_stats = IslandStats();
+    m_stats.islandCount = islandCount;
+
+    for (uint32_t k = 0; k < islandCount; ++k) {
+        bool allSleeping = true;
+        for (uint32_t m = m_offsets[k]; m < m_offsets[k + 1] && allSleeping; ++m) {
+            allSleeping = bodies.IsSleeping(bodies.DenseIndex(m_members[m]));
+        }
+        SetSleeping(bodies, k, allSleeping);
+    }
+
+    m_dirty = false;
+}
+
+bool IslandManager::UpdateSleep(BodyStore& bodies, float deltaTime, float energyThreshold, int sleepSteps) {
+    bool fellAsleep = false;
+    const uint32_t islandCount = static_cast<uint32_t>(m_sleeping.size());
+    // Borne sur la vitesse d'un pas, plus lâche que celle de la fenêtre : un
+    // corps en vol dont la fenêtre encadre l'apogée revient à son point de
+    // départ, mais va vite aux deux bouts. Mesurée sur le centre de masse, que
+    // les corrections internes d'un ragdoll ne déplacent pas.
+    const float peakSpeedSquaredLimit = 2.0f * energyThreshold * PeakEnergyFactor;
+
+    for (uint32_t k = 0; k < islandCount; ++k) {
+        if (m_sleeping[k]) continue;
+        // Gelé : l'îlot ne bouge pas, sans être calme pour autant
+        if (bodies.IsFrozen(bodies.DenseIndex(m_members[m_offsets[k]]))) continue;
+
+        glm::vec3 shift(0.0f);
+        float islandMass = 0.0f;
+        for (uint32_t m = m_offsets[k]; m < m_offsets[k + 1]; ++m) {
+            uint32_t i = bodies.DenseIndex(m_members[m]);
+            float mass = bodies.mass[i] > 0.0f ? bodies.mass[i] : 1.0f;
+            shift += mass * (bodies.Position(i) - bodies.PreviousPosition(i));
+            islandMass += mass;
+        }
+        glm::vec3 velocity = shift / (islandMass * deltaTime);
+        m_peakSpeeds[k] = std::max(m_peakSpeeds[k], glm::dot(velocity, velocity));
+        if (++m_quietSteps[k] < sleepSteps) continue;
+
+        // Énergie cinétique de l'îlot à la vitesse moyenne de la fenêtre,
+        // comparée au seuil par unité de masse
+        float window = m_quietSteps[k] * deltaTime;
+        float energy = 0.0f;
+        float totalMass = 0.0f;
+        for (uint32_t m = m_offsets[k]; m < m_offsets[k + 1]; ++m) {
+            uint32_t i = bodies.DenseIndex(m_members[m]);
+            float mass = bodies.mass[i] > 0.0f ? bodies.mass[i] : 1.0f;
+            glm::vec3 velocity = (bodies.Position(i) - m_anchors[m]) / window;
+            energy += 0.5f * mass * glm::dot(velocity, velocity);
+            totalMass += mass;
+        }
+
+        if (energy <= energyThreshold * totalMass && m_peakSpeeds[k] <= peakSpeedSquaredLimit) {
+            SetSleeping(bodies, k, true);
+            fellAsleep = true;
+        } else {
+            ResetWindow(bodies, k);
+        }
+    }
+
+    return fellAsleep;
+}
+
+bool IslandManager::Wake(BodyStore& bodies, BodyHandle body) {
+    if (body.index >= m_islandOf.size()) return false;
+    uint32_t island = m_islandOf[body.index];
+    if (island == NoIsland || !m_sleeping[island]) return false;
+
+    SetSleeping(bodies, island, false);
+    return true;
+}
+
+void IslandManager::WakeAll(BodyStore& bodies) {
+    for (uint32_t k = 0; k < m_sleeping.size(); ++k) {
+        if (m_sleeping[k]) SetSleeping(bodies, k, false);
+    }
+}
+
+void IslandManager::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_islandOf);
+    writer.WriteArray(m_offsets);
+    writer.WriteArray(m_members);
+    writer.WriteArray(m_anchors);
+    writer.WriteArray(m_quietSteps);
+    writer.WriteArray(m_peakSpeeds);
+    writer.WriteArray(m_sleeping);
+    writer.Write(m_stats);
+    writer.Write(m_dirty);
+}
+
+bool IslandManager::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_islandOf);
+    reader.ReadArray(m_offsets);
+    reader.ReadArray(m_members);
+    reader.ReadArray(m_anchors);
+    reader.ReadArray(m_quietSteps);
+    reader.ReadArray(m_peakSpeeds);
+    reader.ReadArray(m_sleeping);
+    reader.Read(m_stats);
+    reader.Read(m_dirty);
+    return reader.IsValid();
+}
+
+void IslandManager::SetSleeping(BodyStore& bodies, uint32_t island, bool sleeping) {
+    for (uint32_t m = m_offsets[island]; m < m_offsets[island + 1]; ++m) {
+        // Corps détruit depuis la dernière construction (reconstruction en attente)
+        if (!bodies.IsAlive(m_members[m])) continue;
+
+        uint32_t i = bodies.DenseIndex(m_members[m]);
+        if (sleeping) {
+            // Immobile et sans interpolation résiduelle
+            bodies.flags[i] |= BodyFlag_Sleeping;
+            bodies.SetVelocity(i, glm::vec3(0.0f));
+            bodies.SetPreviousPosition(i, bodies.Position(i));
+        } else {
+            bodies.flags[i] &= ~BodyFlag_Sleeping;
+        }
+    }
+
+    size_t memberCount = m_offsets[island + 1] - m_offsets[island];
+    if (sleeping && !m_sleeping[island]) {
+        m_stats.sleepingIslands++;
+        m_stats.sleepingBodies += memberCount;
+    } else if (!sleeping && m_sleeping[island]) {
+        m_stats.sleepingIslands--;
+        m_stats.sleepingBodies -= memberCount;
+    }
+    m_sleeping[island] = sleeping ? 1 : 0;
+    ResetWindow(bodies, island);
+}
+
+void IslandManager::ResetWindow(const BodyStore& bodies, uint32_t island) {
+    for (uint32_t m = m_offsets[island]; m < m_offsets[island + 1]; ++m) {
+        if (!bodies.IsAlive(m_members[m])) continue;
+        m_anchors[m] = bodies.Position(bodies.DenseIndex(m_members[m]));
+    }
+    m_quietSteps[island] = 0;
+    m_peakSpeeds[island] = 0.0f;
+}
+
+} // namespace Engine
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "body_store.h"
+#include "snapshot.h"
+
+namespace Engine {
+
+// Compteurs des îlots (mis à jour à chaque pas)
+struct IslandStats {
+    size_t islandCount = 0;
+    size_t sleepingIslands = 0;
+    size_t sleepingBodies = 0;
+};
+
+// Îlots de simulation : composantes connexes du graphe des contraintes.
+// Les corps cinématiques n'appartiennent à aucun îlot et ne relient rien.
+// Un îlot dont l'énergie cinétique par unité de masse reste sous le seuil
+// pendant N pas s'endort ; il se réveille toujours en entier.
+// L'énergie est mesurée sur le déplacement net de la fenêtre de N pas : les
+// corrections de position (contraintes, sol) font vibrer les vitesses d'un
+// ragdoll immobile sans le déplacer. La vitesse du centre de masse doit en plus
+// rester sous une borne plus lâche à chaque pas de la fenêtre : un corps lancé
+// en l'air repasse par son point de départ.
+class IslandManager {
+public:
+    using Link = std::pair<BodyHandle, BodyHandle>;
+
+    void MarkDirty() { m_dirty = true; }
+    bool IsDirty() const { return m_dirty; }
+
+    // Union-find sur les liens. Un îlot reste endormi si tous ses corps
+    // l'étaient déjà ; sinon tous ses corps sont réveillés.
+    void Build(BodyStore& bodies, const std::vector<Link>& links);
+
+    // Avance la fenêtre des îlots éveillés et endort ceux restés calmes
+    // pendant sleepSteps pas (un îlot gelé par le LOD garde sa fenêtre).
+    // Retourne true si au moins un îlot s'est endormi.
+    bool UpdateSleep(BodyStore& bodies, float deltaTime, float energyThreshold, int sleepSteps);
+
+    // Réveille l'îlot du corps. Retourne true s'il dormait.
+    bool Wake(BodyStore& bodies, BodyHandle body);
+    void WakeAll(BodyStore& bodies);
+
+    // fn(members, count) pour chaque îlot éveillé (handles de ses corps)
+    template <typename Fn>
+    void ForEachAwakeIsland(Fn&& fn) const {
+        for (uint32_t k = 0; k < m_sleeping.size(); ++k) {
+            if (m_sleeping[k]) continue;
+            fn(m_members.data() + m_offsets[k], static_cast<size_t>(m_offsets[k + 1] - m_offsets[k]));
+        }
+    }
+
+    const IslandStats& GetStats() const { return m_stats; }
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+private:
+    static constexpr uint32_t NoIsland = 0xFFFFFFFFu;
+    // Énergie instantanée tolérée, en multiple du seuil de la fenêtre
+    static constexpr float PeakEnergyFactor = 25.0f;
+
+    uint32_t Find(uint32_t slot);
+    void SetSleeping(BodyStore& bodies, uint32_t island, bool sleeping);
+    void ResetWindow(const BodyStore& bodies, uint32_t island);
+
+    std::vector<uint32_t> m_parent;   // Union-find (par emplacement de handle)
+    std::vector<uint32_t> m_islandOf; // Îlot de chaque emplacement
+
+    // Membres de l'îlot k : m_members[m_offsets[k], m_offsets[k + 1])
+    std::vector<uint32_t> m_offsets;
+    std::vector<BodyHandle> m_members;
+    std::vector<glm::vec3> m_anchors; // Position de chaque membre au début de la fenêtre
+    std::vector<int> m_quietSteps;    // Pas écoulés dans la fenêtre
+    std::vector<float> m_peakSpeeds;  // Plus grande vitesse² du centre de masse dans la fenêtre
+    std::vector<uint8_t> m_sleeping;
+
+    IslandStats m_stats;
+    bool m_dirty = true;
+};
+
+} // namespace Engine
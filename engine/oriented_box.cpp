@@ -0,0 +1,266 @@
+#include "oriented_box.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Engine {
+
+namespace {
+
+constexpr float EDGE_AXIS_BIAS = 0.01f;      // Une arête ne l'emporte que nettement
+constexpr float DEGENERATE_AXIS = 1.0e-4f;   // Produit vectoriel d'axes quasi parallèles
+
+// ---------------------------------------------------------------------------
+// Chemin scalaire (référence et traitement des AABB restantes)
+// ---------------------------------------------------------------------------
+
+void CollideObbScalar(const OrientedBox& box, const SatAxes& axes, const AabbBatch& aabbs, float* depth,
+                      uint8_t* axis, size_t begin, size_t end) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    for (size_t k = begin; k < end; ++k) {
+        float dx = aabbs.centerX[k] - box.center.x;
+        float dy = aabbs.centerY[k] - box.center.y;
+        float dz = aabbs.centerZ[k] - box.center.z;
+
+        float minOverlap = infinity, bestBiased = infinity, bestOverlap = infinity;
+        float minAxis = 0.0f, bestAxis = 0.0f;
+        for (int a = 0; a < axes.count; ++a) {
+            float reach = ((axes.radius[a] + aabbs.halfX[k] * axes.absX[a]) + aabbs.halfY[k] * axes.absY[a]) +
+                          aabbs.halfZ[k] * axes.absZ[a];
+            float distance = std::abs((dx * axes.x[a] + dy * axes.y[a]) + dz * axes.z[a]);
+            float overlap = reach - distance;
+            float biased = overlap + axes.bias[a];
+            if (overlap < minOverlap) {
+                minOverlap = overlap;
+                minAxis = static_cast<float>(a);
+            }
+            if (biased < bestBiased) {
+                bestBiased = biased;
+                bestOverlap = overlap;
+                bestAxis = static_cast<float>(a);
+            }
+        }
+
+        bool apart = minOverlap < 0.0f;
+        depth[k] = apart ? minOverlap : bestOverlap;
+        axis[k] = static_cast<uint8_t>(apart ? minAxis : bestAxis);
+    }
+}
+
+#if defined(WOBBLY_X86)
+
+// ---------------------------------------------------------------------------
+// SSE4.1 : 4 AABB par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_SSE41
+size_t CollideObbSSE41(const OrientedBox& box, const SatAxes& axes, const AabbBatch& aabbs, float* depth,
+                       uint8_t* axis, size_t count) {
+    const __m128 centerX = _mm_set1_ps(box.center.x);
+    const __m128 centerY = _mm_set1_ps(box.center.y);
+    const __m128 centerZ = _mm_set1_ps(box.center.z);
+    const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&aabbs.centerX[k]), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&aabbs.centerY[k]), centerY);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(&aabbs.centerZ[k]), centerZ);
+        __m128 hx = _mm_loadu_ps(&aabbs.halfX[k]);
+        __m128 hy = _mm_loadu_ps(&aabbs.halfY[k]);
+        __m128 hz = _mm_loadu_ps(&aabbs.halfZ[k]);
+
+        __m128 minOverlap = infinity, bestBiased = infinity, bestOverlap = infinity;
+        __m128 minAxis = zero, bestAxis = zero;
+        for (int a = 0; a < axes.count; ++a) {
+            __m128 reach = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_set1_ps(axes.radius[a]),
+                                                            _mm_mul_ps(hx, _mm_set1_ps(axes.absX[a]))),
+                                                 _mm_mul_ps(hy, _mm_set1_ps(axes.absY[a]))),
+                                      _mm_mul_ps(hz, _mm_set1_ps(axes.absZ[a])));
+            __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_set1_ps(axes.x[a])),
+                                                 _mm_mul_ps(dy, _mm_set1_ps(axes.y[a]))),
+                                      _mm_mul_ps(dz, _mm_set1_ps(axes.z[a])));
+            __m128 overlap = _mm_sub_ps(reach, _mm_andnot_ps(sign, along));
+            __m128 biased = _mm_add_ps(overlap, _mm_set1_ps(axes.bias[a]));
+            __m128 index = _mm_set1_ps(static_cast<float>(a));
+
+            __m128 lower = _mm_cmplt_ps(overlap, minOverlap);
+            minOverlap = _mm_blendv_ps(minOverlap, overlap, lower);
+            minAxis = _mm_blendv_ps(minAxis, index, lower);
+            __m128 better = _mm_cmplt_ps(biased, bestBiased);
+            bestBiased = _mm_blendv_ps(bestBiased, biased, better);
+            bestOverlap = _mm_blendv_ps(bestOverlap, overlap, better);
+            bestAxis = _mm_blendv_ps(bestAxis, index, better);
+        }
+
+        __m128 apart = _mm_cmplt_ps(minOverlap, zero);
+        _mm_storeu_ps(&depth[k], _mm_blendv_ps(bestOverlap, minOverlap, apart));
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvttps_epi32(_mm_blendv_ps(bestAxis, minAxis, apart)));
+        for (int lane = 0; lane < 4; ++lane) {
+            axis[k + lane] = static_cast<uint8_t>(lanes[lane]);
+        }
+    }
+    return k;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 : 8 AABB par itération
+// ---------------------------------------------------------------------------
+
+WOBBLY_TARGET_AVX2
+size_t CollideObbAVX2(const OrientedBox& box, const SatAxes& axes, const AabbBatch& aabbs, float* depth,
+                      uint8_t* axis, size_t count) {
+    const __m256 centerX = _mm256_set1_ps(box.center.x);
+    const __m256 centerY = _mm256_set1_ps(box.center.y);
+    const __m256 centerZ = _mm256_set1_ps(box.center.z);
+    const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&aabbs.centerX[k]), centerX);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&aabbs.centerY[k]), centerY);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&aabbs.centerZ[k]), centerZ);
+        __m256 hx = _mm256_loadu_ps(&aabbs.halfX[k]);
+        __m256 hy = _mm256_loadu_ps(&aabbs.halfY[k]);
+        __m256 hz = _mm256_loadu_ps(&aabbs.halfZ[k]);
+
+        __m256 minOverlap = infinity, bestBiased = infinity, bestOverlap = infinity;
+        __m256 minAxis = zero, bestAxis = zero;
+        for (int a = 0; a < axes.count; ++a) {
+            __m256 reach = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_set1_ps(axes.radius[a]),
+                                                                     _mm256_mul_ps(hx, _mm256_set1_ps(axes.absX[a]))),
+                                                       _mm256_mul_ps(hy, _mm256_set1_ps(axes.absY[a]))),
+                                         _mm256_mul_ps(hz, _mm256_set1_ps(axes.absZ[a])));
+            __m256 along = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, _mm256_set1_ps(axes.x[a])),
+                                                       _mm256_mul_ps(dy, _mm256_set1_ps(axes.y[a]))),
+                                         _mm256_mul_ps(dz, _mm256_set1_ps(axes.z[a])));
+            __m256 overlap = _mm256_sub_ps(reach, _mm256_andnot_ps(sign, along));
+            __m256 biased = _mm256_add_ps(overlap, _mm256_set1_ps(axes.bias[a]));
+            __m256 index = _mm256_set1_ps(static_cast<float>(a));
+
+            __m256 lower = _mm256_cmp_ps(overlap, minOverlap, _CMP_LT_OQ);
+            minOverlap = _mm256_blendv_ps(minOverlap, overlap, lower);
+            minAxis = _mm256_blendv_ps(minAxis, index, lower);
+            __m256 better = _mm256_cmp_ps(biased, bestBiased, _CMP_LT_OQ);
+            bestBiased = _mm256_blendv_ps(bestBiased, biased, better);
+            bestOverlap = _mm256_blendv_ps(bestOverlap, overlap, better);
+            bestAxis = _mm256_blendv_ps(bestAxis, index, better);
+        }
+
+        __m256 apart = _mm256_cmp_ps(minOverlap, zero, _CMP_LT_OQ);
+        _mm256_storeu_ps(&depth[k], _mm256_blendv_ps(bestOverlap, minOverlap, apart));
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes),
+                           _mm256_cvttps_epi32(_mm256_blendv_ps(bestAxis, minAxis, apart)));
+        for (int lane = 0; lane < 8; ++lane) {
+            axis[k + lane] = static_cast<uint8_t>(lanes[lane]);
+        }
+    }
+    return k;
+}
+
+#endif // WOBBLY_X86
+
+} // namespace
+
+glm::vec3 OrientedBox::BoundsHalfExtents() const {
+    return glm::abs(axes[0]) * halfExtents.x + glm::abs(axes[1]) * halfExtents.y + glm::abs(axes[2]) * halfExtents.z;
+}
+
+void OrientedBox::SweptBounds(const glm::vec3& axis, glm::vec3& boundsMin, glm::vec3& boundsMax) const {
+    float length = glm::length(axis);
+    if (!(length > 0.0f)) {
+        boundsMin = center - BoundsHalfExtents();
+        boundsMax = center + BoundsHalfExtents();
+        return;
+    }
+
+    // Le long de l'axe, la boîte garde sa projection ; autour, elle reste
+    // dans un cylindre de rayon (distance du centre à l'axe + demi-diagonale)
+    glm::vec3 unit = axis / length;
+    glm::vec3 onAxis = unit * glm::dot(center, unit);
+    float along = halfExtents.x * std::abs(glm::dot(axes[0], unit)) +
+                  halfExtents.y * std::abs(glm::dot(axes[1], unit)) +
+                  halfExtents.z * std::abs(glm::dot(axes[2], unit));
+    float around = glm::length(center - onAxis) + glm::length(halfExtents);
+
+    glm::vec3 reach;
+    for (int k = 0; k < 3; ++k) {
+        float cosine = std::abs(unit[k]);
+        reach[k] = cosine * along + std::sqrt(std::max(1.0f - cosine * cosine, 0.0f)) * around;
+    }
+    boundsMin = onAxis - reach;
+    boundsMax = onAxis + reach;
+}
+
+void SatAxes::Prepare(const OrientedBox& box) {
+    count = 0;
+    auto add = [&](const glm::vec3& unit, float edgeBias) {
+        x[count] = unit.x;
+        y[count] = unit.y;
+        z[count] = unit.z;
+        absX[count] = std::abs(unit.x);
+        absY[count] = std::abs(unit.y);
+        absZ[count] = std::abs(unit.z);
+        radius[count] = std::abs(glm::dot(box.axes[0], unit)) * box.halfExtents.x +
+                        std::abs(glm::dot(box.axes[1], unit)) * box.halfExtents.y +
+                        std::abs(glm::dot(box.axes[2], unit)) * box.halfExtents.z;
+        bias[count] = edgeBias;
+        count++;
+    };
+
+    const glm::vec3 world[3] = {glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)};
+    for (const glm::vec3& axis : world) add(axis, 0.0f);
+    for (const glm::vec3& axis : box.axes) add(axis, 0.0f);
+    for (const glm::vec3& edge : box.axes) {
+        for (const glm::vec3& axis : world) {
+            glm::vec3 normal = glm::cross(edge, axis);
+            float length = glm::length(normal);
+            if (length > DEGENERATE_AXIS) add(normal / length, EDGE_AXIS_BIAS);
+        }
+    }
+}
+
+void AabbBatch::Clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    halfX.clear();
+    halfY.clear();
+    halfZ.clear();
+}
+
+void AabbBatch::Add(const glm::vec3& center, const glm::vec3& halfExtents) {
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    halfX.push_back(halfExtents.x);
+    halfY.push_back(halfExtents.y);
+    halfZ.push_back(halfExtents.z);
+}
+
+void CollideObbBatch(const OrientedBox& box, const SatAxes& axes, const AabbBatch& aabbs, float* depth,
+                     uint8_t* axis, SimdLevel level) {
+    const size_t count = aabbs.Size();
+    size_t done = 0;
+
+#if defined(WOBBLY_X86)
+    if (level == SimdLevel::AVX2) {
+        done = CollideObbAVX2(box, axes, aabbs, depth, axis, count);
+    } else if (level == SimdLevel::SSE41) {
+        done = CollideObbSSE41(box, axes, aabbs, depth, axis, count);
+    }
+#else
+    (void)level;
+#endif
+
+    CollideObbScalar(box, axes, aabbs, depth, axis, done, count);
+}
+
+} // namespace Engine
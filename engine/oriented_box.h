@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "body_store.h"
+#include "integrator.h"
+
+namespace Engine {
+
+// Boîte orientée (OBB) : centre, axes unitaires orthogonaux et demi-dimensions
+// le long de chacun
+struct OrientedBox {
+    glm::vec3 center{0.0f};
+    glm::vec3 axes[3] = {glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)};
+    glm::vec3 halfExtents{0.5f};
+
+    // Demi-dimensions de l'AABB qui l'englobe
+    glm::vec3 BoundsHalfExtents() const;
+    // AABB qui l'englobe pendant un tour complet autour de l'axe (passant par
+    // l'origine) ; axe nul : la pose actuelle seulement
+    void SweptBounds(const glm::vec3& axis, glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+};
+
+// Axes de séparation d'une OBB contre des AABB : les 3 axes du monde, les 3
+// de la boîte et leurs produits vectoriels non dégénérés (15 au plus).
+// Tout ce qui ne dépend que de l'OBB est calculé ici, une fois par lot.
+struct SatAxes {
+    static constexpr int MaxAxes = 15;
+
+    void Prepare(const OrientedBox& box);
+    glm::vec3 Axis(int k) const { return {x[k], y[k], z[k]}; }
+
+    int count = 0;
+    float x[MaxAxes], y[MaxAxes], z[MaxAxes];          // Axe unitaire
+    float absX[MaxAxes], absY[MaxAxes], absZ[MaxAxes]; // |axe| : projection d'une AABB
+    float radius[MaxAxes]; // Demi-épaisseur de l'OBB le long de l'axe
+    float bias[MaxAxes];   // Pénalité des axes d'arête (les faces d'abord)
+};
+
+// AABB à tester contre une même OBB, en SoA
+struct AabbBatch {
+    void Clear();
+    void Add(const glm::vec3& center, const glm::vec3& halfExtents);
+    size_t Size() const { return centerX.size(); }
+
+    AlignedVector<float> centerX, centerY, centerZ;
+    AlignedVector<float> halfX, halfY, halfZ;
+};
+
+// Test SAT d'une OBB contre chaque AABB du lot. depth[k] : recouvrement le
+// long de axis[k] (indice dans axes), négatif si les boîtes sont écartées.
+// En recouvrement, l'axe de moindre pénétration ; sinon celui qui les sépare
+// le plus. Les chemins SIMD donnent exactement les résultats du scalaire.
+void CollideObbBatch(const OrientedBox& box, const SatAxes& axes, const AabbBatch& aabbs, float* depth,
+                     uint8_t* axis, SimdLevel level);
+
+} // namespace Engine
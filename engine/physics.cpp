@@ -1,194 +1,1605 @@
 #include "physics.h"
+#include "thread_pool.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <limits>
 
 namespace Engine {
 
-PhysicsEngine::PhysicsEngine() {}
+PhysicsEngine::PhysicsEngine()
+    : m_simdLevel(DetectSimdLevel()) {}
 
 PhysicsEngine::~PhysicsEngine() {}
 
-RigidBody* PhysicsEngine::CreateRigidBody() {
-    auto body = std::make_unique<RigidBody>();
-    RigidBody* ptr = body.get();
-    m_bodies.push_back(std::move(body));
-    return ptr;
+BodyHandle PhysicsEngine::CreateRigidBody(const RigidBody& desc) {
+    BodyHandle handle = m_bodies.Create();
+    uint32_t i = m_bodies.DenseIndex(handle);
+
+    m_bodies.SetPosition(i, desc.position);
+    m_bodies.SetPreviousPosition(i, desc.position);
+    m_bodies.SetVelocity(i, desc.velocity);
+    m_bodies.SetForce(i, glm::vec3(0.0f));
+    m_bodies.SetBox(i, desc.boxMin, desc.boxMax);
+    m_bodies.mass[i] = desc.mass;
+    m_bodies.friction[i] = desc.friction;
+    m_bodies.restitution[i] = desc.restitution;
+    m_bodies.groundY[i] = m_terrain.HeightAt(desc.position.x, desc.position.z);
+    m_bodies.collisionGroup[i] = desc.collisionGroup;
+    m_bodies.flags[i] = (desc.isKinematic || desc.isStatic ? BodyFlag_Kinematic : 0) |
+                        (desc.isStatic ? BodyFlag_Static : 0) |
+                        (desc.useGravity ? BodyFlag_UseGravity : 0);
+
+    // Les corps statiques vont dans le BVH, les autres dans la broadphase
+    if (desc.isStatic) {
+        m_staticBodies.push_back(handle);
+        m_staticDirty = true;
+    } else {
+        m_broadphase.AddBody(handle);
+        MarkQueryIndexDirty(true);
+    }
+    m_islands.MarkDirty();
+    m_layoutDirty = true;
+    return handle;
 }
 
-void PhysicsEngine::RemoveRigidBody(RigidBody* body) {
-    m_bodies.erase(
-        std::remove_if(m_bodies.begin(), m_bodies.end(),
-            [body](const auto& b) { return b.get() == body; }),
-        m_bodies.end()
-    );
+void PhysicsEngine::RemoveRigidBody(BodyHandle body) {
+    if (!m_bodies.IsAlive(body)) return;
+
+    // Ce qui reposait sur ce corps ou y était attaché doit se réveiller
+    uint32_t i = m_bodies.DenseIndex(body);
+    if (m_bodies.IsStatic(i)) {
+        WakeTouching(i);
+        m_staticBodies.erase(std::find(m_staticBodies.begin(), m_staticBodies.end(), body));
+        m_staticDirty = true;
+    }
+    WakeDense(i);
+    for (const auto& pair : m_broadphase.GetPairs()) {
+        if (pair.bodyA != body && pair.bodyB != body) continue;
+        BodyHandle other = pair.bodyA == body ? pair.bodyB : pair.bodyA;
+        if (!m_bodies.IsAlive(other)) continue;
+
+        uint32_t j = m_bodies.DenseIndex(other);
+        if (CheckCollisionDense(i, j)) WakeDense(j);
+    }
+
+    if (!m_bodies.IsStatic(i)) {
+        MarkQueryIndexDirty(true);
+    }
+    if (m_bodies.flags[i] & BodyFlag_Oriented) {
+        RemoveOriented(body);
+    }
+    m_broadphase.RemoveBody(body);
+    m_bodies.Destroy(body);
+
+    // Les contraintes qui référencent ce corps sont purgées au prochain Update
+    m_hasDeadConstraints = true;
+    m_islands.MarkDirty();
+    m_layoutDirty = true;
+}
+
+RigidBody PhysicsEngine::GetBody(BodyHandle body) const {
+    RigidBody desc;
+    if (!m_bodies.IsAlive(body)) return desc;
+
+    uint32_t i = m_bodies.DenseIndex(body);
+    desc.position = m_bodies.Position(i);
+    desc.velocity = m_bodies.Velocity(i);
+    desc.mass = m_bodies.mass[i];
+    desc.friction = m_bodies.friction[i];
+    desc.restitution = m_bodies.restitution[i];
+    desc.useGravity = (m_bodies.flags[i] & BodyFlag_UseGravity) != 0;
+    desc.isKinematic = m_bodies.IsKinematic(i);
+    desc.isStatic = m_bodies.IsStatic(i);
+    desc.boxMin = m_bodies.BoxMin(i);
+    desc.boxMax = m_bodies.BoxMax(i);
+    desc.collisionGroup = m_bodies.collisionGroup[i];
+    return desc;
+}
+
+glm::vec3 PhysicsEngine::GetPosition(BodyHandle body) const {
+    if (!m_bodies.IsAlive(body)) return glm::vec3(0.0f);
+    return m_bodies.Position(m_bodies.DenseIndex(body));
+}
+
+glm::vec3 PhysicsEngine::GetInterpolatedPosition(BodyHandle body) const {
+    if (!m_bodies.IsAlive(body)) return glm::vec3(0.0f);
+    uint32_t i = m_bodies.DenseIndex(body);
+    glm::vec3 previous = m_bodies.PreviousPosition(i);
+    return previous + (m_bodies.Position(i) - previous) * m_timestepStats.interpolationAlpha;
+}
+
+glm::vec3 PhysicsEngine::GetVelocity(BodyHandle body) const {
+    if (!m_bodies.IsAlive(body)) return glm::vec3(0.0f);
+    return m_bodies.Velocity(m_bodies.DenseIndex(body));
+}
+
+glm::vec3 PhysicsEngine::GetBoxSize(BodyHandle body) const {
+    if (!m_bodies.IsAlive(body)) return glm::vec3(0.0f);
+    uint32_t i = m_bodies.DenseIndex(body);
+    return m_bodies.BoxMax(i) - m_bodies.BoxMin(i);
+}
+
+void PhysicsEngine::SetPosition(BodyHandle body, const glm::vec3& position) {
+    if (!m_bodies.IsAlive(body)) return;
+    // Téléportation : pas d'interpolation depuis l'ancienne position
+    uint32_t i = m_bodies.DenseIndex(body);
+    if (m_bodies.IsStatic(i)) {
+        // Rien ne doit rester suspendu à l'ancienne position
+        WakeTouching(i);
+        m_staticDirty = true;
+    }
+    m_bodies.SetPosition(i, position);
+    m_bodies.SetPreviousPosition(i, position);
+
+    // Un cinématique déplacé réveille ce qu'il touche au prochain pas
+    if (m_bodies.IsStatic(i)) {
+        WakeTouching(i);
+    } else if (m_bodies.IsKinematic(i)) {
+        m_bodies.flags[i] |= BodyFlag_Moved;
+        MarkQueryIndexDirty(false);
+    } else {
+        WakeDense(i);
+        MarkQueryIndexDirty(false);
+    }
+}
+
+void PhysicsEngine::SetVelocity(BodyHandle body, const glm::vec3& velocity) {
+    if (!m_bodies.IsAlive(body)) return;
+    uint32_t i = m_bodies.DenseIndex(body);
+    WakeDense(i);
+    m_bodies.SetVelocity(i, velocity);
+}
+
+void PhysicsEngine::ClearForces(BodyHandle body) {
+    if (!m_bodies.IsAlive(body)) return;
+    m_bodies.SetForce(m_bodies.DenseIndex(body), glm::vec3(0.0f));
+}
+
+void PhysicsEngine::SetOrientation(BodyHandle body, const glm::mat3& rotation, const glm::vec3& angularVelocity) {
+    if (!m_bodies.IsAlive(body)) return;
+    // Les corps dynamiques n'ont pas de rotation intégrée
+    uint32_t i = m_bodies.DenseIndex(body);
+    if (!m_bodies.IsKinematic(i)) return;
+
+    uint32_t slot = m_orientedIndex.Find(body.index);
+    if (slot == PairIndex::NotFound) {
+        // La boîte actuelle devient la boîte orientée, axes du monde au repos
+        OrientedBody oriented;
+        oriented.body = body;
+        oriented.shape.center = (m_bodies.BoxMin(i) + m_bodies.BoxMax(i)) * 0.5f;
+        oriented.shape.halfExtents = (m_bodies.BoxMax(i) - m_bodies.BoxMin(i)) * 0.5f;
+        slot = static_cast<uint32_t>(m_oriented.size());
+        m_oriented.push_back(oriented);
+        m_orientedIndex.Set(body.index, slot);
+        m_bodies.flags[i] |= BodyFlag_Oriented;
+    }
+
+    OrientedBody& oriented = m_oriented[slot];
+    for (int axis = 0; axis < 3; ++axis) {
+        oriented.shape.axes[axis] = rotation[axis];
+    }
+    oriented.angularVelocity = angularVelocity;
+
+    OrientedBox box = WorldBox(oriented);
+    box.center -= m_bodies.Position(i);
+    if (m_bodies.IsStatic(i)) {
+        // Statique : le BVH garde l'enveloppe de sa rotation autour de
+        // angularVelocity. Elle ne grandit (et le BVH n'est reconstruit) que
+        // si une pose en sort.
+        glm::vec3 sweptMin, sweptMax;
+        box.SweptBounds(angularVelocity, sweptMin, sweptMax);
+        glm::vec3 boxMin = m_bodies.BoxMin(i);
+        glm::vec3 boxMax = m_bodies.BoxMax(i);
+        if (sweptMin.x < boxMin.x || sweptMin.y < boxMin.y || sweptMin.z < boxMin.z ||
+            sweptMax.x > boxMax.x || sweptMax.y > boxMax.y || sweptMax.z > boxMax.z) {
+            m_bodies.SetBox(i, glm::min(boxMin, sweptMin), glm::max(boxMax, sweptMax));
+            m_staticDirty = true;
+            WakeTouching(i);
+        }
+        return;
+    }
+
+    // BodyStore garde l'AABB englobante : broadphase, requêtes et rendu
+    glm::vec3 half = box.BoundsHalfExtents();
+    m_bodies.SetBox(i, box.center - half, box.center + half);
+    m_bodies.flags[i] |= BodyFlag_Moved;
+    MarkQueryIndexDirty(false);
+}
+
+glm::mat3 PhysicsEngine::GetOrientation(BodyHandle body) const {
+    uint32_t slot = m_bodies.IsAlive(body) ? m_orientedIndex.Find(body.index) : PairIndex::NotFound;
+    if (slot == PairIndex::NotFound) return glm::mat3(1.0f);
+    const OrientedBox& shape = m_oriented[slot].shape;
+    return glm::mat3(shape.axes[0], shape.axes[1], shape.axes[2]);
+}
+
+void PhysicsEngine::RemoveOriented(BodyHandle body) {
+    uint32_t slot = m_orientedIndex.Find(body.index);
+    if (slot == PairIndex::NotFound) return;
+
+    // Le dernier prend la place du retiré
+    const OrientedBody& last = m_oriented.back();
+    m_orientedIndex.Set(last.body.index, slot);
+    m_oriented[slot] = last;
+    m_oriented.pop_back();
+    m_orientedIndex.Erase(body.index);
+}
+
+OrientedBox PhysicsEngine::WorldBox(const OrientedBody& oriented) const {
+    OrientedBox box = oriented.shape;
+    const glm::vec3& local = oriented.shape.center;
+    box.center = m_bodies.Position(m_bodies.DenseIndex(oriented.body)) +
+                 ((box.axes[0] * local.x + box.axes[1] * local.y) + box.axes[2] * local.z);
+    return box;
+}
+
+void PhysicsEngine::SetSleepingEnabled(bool enabled) {
+    m_sleepingEnabled = enabled;
+    if (!enabled) {
+        m_islands.WakeAll(m_bodies);
+        m_layoutDirty = true;
+    }
+}
+
+void PhysicsEngine::SetSleepThreshold(float energyPerKg, int sleepSteps) {
+    m_sleepEnergy = std::max(energyPerKg, 0.0f);
+    m_sleepSteps = std::max(1, sleepSteps);
+}
+
+void PhysicsEngine::SetLodSettings(const LodSettings& settings) {
+    // Distances croissantes et positives
+    m_lod = settings;
+    m_lod.halfRateDistance = std::max(m_lod.halfRateDistance, 0.0f);
+    m_lod.quarterRateDistance = std::max(m_lod.quarterRateDistance, m_lod.halfRateDistance);
+    m_lod.freezeDistance = std::max(m_lod.freezeDistance, m_lod.quarterRateDistance);
+    m_lod.hysteresis = std::max(m_lod.hysteresis, 0.0f);
+    m_layoutDirty = true;
+    if (m_lod.enabled) return;
+
+    // Sans LOD, tout repasse au plein régime
+    for (uint32_t i = 0; i < m_bodies.Size(); ++i) {
+        m_bodies.lod[i] = 0;
+        m_bodies.flags[i] &= ~BodyFlag_Frozen;
+    }
+    m_lodStats = LodStats();
+}
+
+bool PhysicsEngine::IsSleeping(BodyHandle body) const {
+    if (!m_bodies.IsAlive(body)) return false;
+    return m_bodies.IsSleeping(m_bodies.DenseIndex(body));
+}
+
+void PhysicsEngine::WakeBody(BodyHandle body) {
+    if (!m_bodies.IsAlive(body)) return;
+    WakeDense(m_bodies.DenseIndex(body));
+}
+
+void PhysicsEngine::WakeDense(uint32_t i) {
+    if (!m_bodies.IsSleeping(i)) return;
+    if (m_islands.Wake(m_bodies, m_bodies.HandleAt(i))) {
+        m_layoutDirty = true;
+    }
+}
+
+void PhysicsEngine::WakeTouching(uint32_t i) {
+    // Rare (géométrie statique modifiée) : un simple parcours suffit
+    const uint32_t count = static_cast<uint32_t>(m_bodies.Size());
+    for (uint32_t j = 0; j < count; ++j) {
+        if (m_bodies.IsSleeping(j) && CheckCollisionDense(i, j)) {
+            WakeDense(j);
+        }
+    }
 }
 
-void PhysicsEngine::AddConstraint(RigidBody* a, RigidBody* b, float length) {
-    m_constraints.emplace_back(a, b, length);
+void PhysicsEngine::SetTerrain(const Heightfield& terrain) {
+    m_terrain = terrain;
+    m_islands.WakeAll(m_bodies);
+    m_layoutDirty = true;
+    for (uint32_t i = 0; i < m_bodies.Size(); ++i) {
+        m_bodies.groundY[i] = m_terrain.HeightAt(m_bodies.posX[i], m_bodies.posZ[i]);
+    }
+}
+
+void PhysicsEngine::RebuildStaticGeometry() {
+    m_staticGeometry.Build(m_bodies, m_staticBodies);
+    m_staticDirty = false;
+}
+
+void PhysicsEngine::SetSimdLevel(SimdLevel level) {
+    // Ne jamais dépasser ce que le CPU supporte
+    m_simdLevel = std::min(level, DetectSimdLevel());
+}
+
+void PhysicsEngine::AddConstraint(BodyHandle a, BodyHandle b, float length, float compliance) {
+    m_constraints.emplace_back(a, b, length, std::max(compliance, 0.0f));
+    m_constraintsDirty = true;
+}
+
+void PhysicsEngine::AddSkeleton(const void* topology, size_t partCount, const SkeletonJoint* joints,
+                                size_t jointCount, SkeletonSolveFn solve, const BodyHandle* parts) {
+    auto group = std::find_if(m_skeletons.begin(), m_skeletons.end(),
+                              [topology](const SkeletonGroup& g) { return g.topology == topology; });
+    if (group == m_skeletons.end()) {
+        SkeletonGroup created;
+        created.topology = topology;
+        created.partCount = partCount;
+        created.joints.assign(joints, joints + jointCount);
+        created.solve = solve;
+        group = m_skeletons.insert(m_skeletons.end(), std::move(created));
+    }
+    group->bodies.insert(group->bodies.end(), parts, parts + partCount);
+    m_constraintsDirty = true;
 }
 
-void PhysicsEngine::ApplyForce(RigidBody* body, const glm::vec3& force) {
-    if (!body || body->isKinematic) return;
-    body->force += force;
+size_t PhysicsEngine::GetSkeletonCount() const {
+    size_t count = 0;
+    for (const auto& group : m_skeletons) {
+        count += group.bodies.size() / group.partCount;
+    }
+    return count;
 }
 
-void PhysicsEngine::ApplyImpulse(RigidBody* body, const glm::vec3& impulse) {
-    if (!body || body->isKinematic) return;
-    body->velocity += impulse / body->mass;
+void PhysicsEngine::SetWorkerThreads(size_t threadCount) {
+    if (threadCount <= 1) {
+        m_threadPool.reset();
+    } else if (!m_threadPool || m_threadPool->GetThreadCount() != threadCount) {
+        m_threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+}
+
+size_t PhysicsEngine::GetWorkerThreads() const {
+    return m_threadPool ? m_threadPool->GetThreadCount() : 1;
+}
+
+void PhysicsEngine::SetSolverIterations(int minIterations, int maxIterations) {
+    m_minIterations = std::max(1, minIterations);
+    m_maxIterations = std::max(m_minIterations, maxIterations);
+}
+
+void PhysicsEngine::ApplyForce(BodyHandle body, const glm::vec3& force) {
+    if (!m_bodies.IsAlive(body)) return;
+    uint32_t i = m_bodies.DenseIndex(body);
+    if (m_bodies.IsKinematic(i)) return;
+    WakeDense(i);
+    m_bodies.SetForce(i, m_bodies.Force(i) + force);
+}
+
+void PhysicsEngine::ApplyImpulse(BodyHandle body, const glm::vec3& impulse) {
+    if (!m_bodies.IsAlive(body)) return;
+    uint32_t i = m_bodies.DenseIndex(body);
+    if (m_bodies.IsKinematic(i)) return;
+    WakeDense(i);
+    m_bodies.SetVelocity(i, m_bodies.Velocity(i) + impulse / m_bodies.mass[i]);
+}
+
+void PhysicsEngine::SetFixedTimestep(float hz) {
+    m_fixedDelta = hz > 0.0f ? 1.0f / hz : 0.0f;
+    m_accumulator = 0.0f;
 }
 
 void PhysicsEngine::Update(float deltaTime) {
-    // Limiter le pas de temps pour la stabilité
-    const float maxDelta = 0.02f;
-    deltaTime = std::min(deltaTime, maxDelta);
-    
-    // Intégration des forces
-    for (auto& body : m_bodies) {
-        if (!body->isKinematic) {
-            IntegrateForces(*body, deltaTime);
+    ScopedFloatEnvironment floatEnvironment(m_deterministic);
+#if defined(WOBBLY_PROFILING)
+    m_profiler.BeginFrame();
+#endif
+
+    m_timestepStats.substeps = 0;
+    m_timestepStats.droppedSteps = 0;
+    m_contactEvents.ClearEvents();
+    m_solverStats.totalIterations = 0;
+    m_solverStats.budgetStops = 0;
+    m_solverStats.iterationLimitStops = 0;
+
+    if (m_fixedDelta <= 0.0f) {
+        // Mode variable : limiter le pas de temps pour la stabilité
+        const float maxDelta = 0.02f;
+        Step(std::min(deltaTime, maxDelta));
+        m_timestepStats.substeps = 1;
+        m_timestepStats.interpolationAlpha = 1.0f;
+    } else {
+        // Mode fixe : consommer le temps écoulé par pas constants
+        m_accumulator += std::max(deltaTime, 0.0f);
+        while (m_accumulator >= m_fixedDelta && m_timestepStats.substeps < m_maxSubsteps) {
+            Step(m_fixedDelta);
+            m_accumulator -= m_fixedDelta;
+            m_timestepStats.substeps++;
+        }
+
+        // Trop de retard : abandonner les pas restants plutôt que de s'effondrer
+        if (m_accumulator >= m_fixedDelta) {
+            float behind = std::floor(m_accumulator / m_fixedDelta);
+            m_timestepStats.droppedSteps = static_cast<int>(behind);
+            m_accumulator -= behind * m_fixedDelta;
         }
+
+        m_timestepStats.interpolationAlpha = m_accumulator / m_fixedDelta;
+    }
+
+    // Les forces appliquées depuis le dernier Update agissent pendant tous
+    // ses sous-pas ; on les garde si aucun pas n'a encore été simulé
+    if (m_timestepStats.substeps > 0) {
+        MarkQueryIndexDirty(false);
+        std::fill(m_bodies.forceX.begin(), m_bodies.forceX.end(), 0.0f);
+        std::fill(m_bodies.forceY.begin(), m_bodies.forceY.end(), 0.0f);
+        std::fill(m_bodies.forceZ.begin(), m_bodies.forceZ.end(), 0.0f);
+    }
+
+#if defined(WOBBLY_PROFILING)
+    // Un Update sans pas (pas fixe en avance) n'est pas enregistré
+    if (m_timestepStats.substeps > 0) {
+        PhysicsProfileFrame counters;
+        counters.steps = static_cast<uint32_t>(m_timestepStats.substeps);
+        counters.bodies = static_cast<uint32_t>(m_bodies.Size());
+        counters.awakeBodies = m_awakeCount;
+        counters.activePairs = static_cast<uint32_t>(m_collisionStats.persistentPairs);
+        counters.pairsTested = static_cast<uint32_t>(m_collisionStats.pairsTested);
+        counters.contacts = static_cast<uint32_t>(m_collisionStats.contacts);
+        counters.iterations = static_cast<uint32_t>(m_solverStats.totalIterations);
+        m_profiler.EndFrame(counters);
+    }
+#endif
+}
+
+namespace {
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534257; // "WBSN"
+constexpr uint32_t SNAPSHOT_VERSION = 10;
+
+// Change dès que la disposition des structures copiées change
+constexpr uint32_t SnapshotLayout() {
+    return static_cast<uint32_t>(sizeof(BodyHandle) * 1 + sizeof(Constraint) * 3 +
+                                 sizeof(CollisionStats) * 5 + sizeof(TimestepStats) * 7 +
+                                 sizeof(IslandStats) * 11 + sizeof(glm::vec3) * 13 +
+                                 sizeof(Contact) * 17 + sizeof(SolverStats) * 19 +
+                                 sizeof(ContactEvent) * 23 + sizeof(OrientedBody) * 29 +
+                                 sizeof(LodSettings) * 31 + sizeof(LodStats) * 37);
+}
+
+// Clé d'une paire de corps, indépendante de l'ordre
+uint64_t JointKey(BodyHandle a, BodyHandle b) {
+    uint32_t low = std::min(a.index, b.index);
+    uint32_t high = std::max(a.index, b.index);
+    return (static_cast<uint64_t>(low) << 32) | high;
+}
+
+} // namespace
+
+void PhysicsEngine::SaveState(SnapshotBlob& blob) const {
+    SnapshotWriter writer(blob);
+    SaveState(writer);
+}
+
+bool PhysicsEngine::LoadState(const SnapshotBlob& blob) {
+    SnapshotReader reader(blob);
+    return LoadState(reader) && reader.AtEnd();
+}
+
+void PhysicsEngine::SaveState(SnapshotWriter& writer) const {
+    writer.Write(SNAPSHOT_MAGIC);
+    writer.Write(SNAPSHOT_VERSION);
+    writer.Write(SnapshotLayout());
+
+    m_bodies.SaveState(writer);
+
+    writer.WriteArray(m_constraints);
+    writer.Write(m_hasDeadConstraints);
+    writer.WriteArray(m_colorOffsets);
+    writer.Write(m_serialBatch);
+    writer.Write(m_constraintsDirty);
+    m_jointedPairs.SaveState(writer);
+    writer.Write(m_lastCollisionGroup);
+    writer.Write(static_cast<uint64_t>(m_skeletons.size()));
+    for (const auto& group : m_skeletons) {
+        writer.Write(static_cast<uint64_t>(group.partCount));
+        writer.WriteArray(group.bodies);
+    }
+
+    m_broadphase.SaveState(writer);
+    writer.Write(m_collisionStats);
+    m_terrain.SaveState(writer);
+    writer.WriteArray(m_oriented);
+    m_orientedIndex.SaveState(writer);
+    m_contacts.SaveState(writer);
+    m_contactEvents.SaveState(writer);
+    m_staticGeometry.SaveState(writer);
+    writer.WriteArray(m_staticBodies);
+    writer.Write(m_staticDirty);
+
+    writer.Write(m_gravity);
+    m_islands.SaveState(writer);
+    writer.Write(m_sleepingEnabled);
+    writer.Write(m_sleepEnergy);
+    writer.Write(m_sleepSteps);
+
+    writer.Write(m_fixedDelta);
+    writer.Write(m_accumulator);
+    writer.Write(m_maxSubsteps);
+    writer.Write(m_timestepStats);
+
+    writer.Write(m_solverTolerance);
+    writer.Write(m_minIterations);
+    writer.Write(m_maxIterations);
+    writer.Write(m_solverTimeBudget);
+    writer.Write(m_solverStats);
+    writer.Write(m_solverMode);
+    writer.Write(m_xpbdSubsteps);
+
+    writer.Write(m_lod);
+    writer.Write(m_lodStats);
+    writer.Write(m_lodFocus);
+    writer.Write(m_lodStep);
+}
+
+bool PhysicsEngine::LoadState(SnapshotReader& reader) {
+    uint32_t magic = 0, version = 0, layout = 0;
+    reader.Read(magic);
+    reader.Read(version);
+    reader.Read(layout);
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || layout != SnapshotLayout()) {
+        return false;
+    }
+
+    m_bodies.LoadState(reader);
+
+    reader.ReadArray(m_constraints);
+    reader.Read(m_hasDeadConstraints);
+    reader.ReadArray(m_colorOffsets);
+    reader.Read(m_serialBatch);
+    reader.Read(m_constraintsDirty);
+    m_jointedPairs.LoadState(reader);
+    reader.Read(m_lastCollisionGroup);
+    // Les topologies (solveurs) ne sont pas sérialisables : le moteur doit
+    // avoir enregistré les mêmes, seuls les corps de chaque squelette sont relus
+    uint64_t skeletonGroups = 0;
+    reader.Read(skeletonGroups);
+    if (skeletonGroups != m_skeletons.size()) return false;
+    for (auto& group : m_skeletons) {
+        uint64_t partCount = 0;
+        reader.Read(partCount);
+        if (partCount != group.partCount) return false;
+        reader.ReadArray(group.bodies);
     }
-    
-    // Résoudre les contraintes (articulations)
-    for (int i = 0; i < CONSTRAINT_ITERATIONS; ++i) {
-        SolveConstraints();
+
+    m_broadphase.LoadState(reader);
+    reader.Read(m_collisionStats);
+    if (!m_terrain.LoadState(reader)) return false;
+    reader.ReadArray(m_oriented);
+    m_orientedIndex.LoadState(reader);
+    m_contacts.LoadState(reader);
+    m_contactEvents.LoadState(reader);
+    m_staticGeometry.LoadState(reader);
+    reader.ReadArray(m_staticBodies);
+    reader.Read(m_staticDirty);
+
+    reader.Read(m_gravity);
+    m_islands.LoadState(reader);
+    reader.Read(m_sleepingEnabled);
+    reader.Read(m_sleepEnergy);
+    reader.Read(m_sleepSteps);
+
+    reader.Read(m_fixedDelta);
+    reader.Read(m_accumulator);
+    reader.Read(m_maxSubsteps);
+    reader.Read(m_timestepStats);
+
+    reader.Read(m_solverTolerance);
+    reader.Read(m_minIterations);
+    reader.Read(m_maxIterations);
+    reader.Read(m_solverTimeBudget);
+    reader.Read(m_solverStats);
+    reader.Read(m_solverMode);
+    reader.Read(m_xpbdSubsteps);
+
+    reader.Read(m_lod);
+    reader.Read(m_lodStats);
+    reader.Read(m_lodFocus);
+    reader.Read(m_lodStep);
+
+    // Les listes de contraintes éveillées se recalculent à l'identique :
+    // les corps sont déjà partitionnés dans l'ordre sauvegardé
+    m_layoutDirty = true;
+    MarkQueryIndexDirty(true);
+    return reader.IsValid();
+}
+
+void PhysicsEngine::Step(float deltaTime) {
+    LodPasses passes;
+    const size_t passCount = GetLodPasses(passes);
+    {
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Prepare);
+        if (m_hasDeadConstraints) {
+            PurgeDeadConstraints();
+        }
+        if (m_constraintsDirty) {
+            ColorConstraints();
+            RebuildJointFilter();
+            m_islands.MarkDirty();
+        }
+        if (m_islands.IsDirty()) {
+            RebuildIslands();
+        }
+        if (m_staticDirty) {
+            RebuildStaticGeometry();
+        }
+        // Aux multiples de LodInterval, tous les créneaux sont au même instant :
+        // un îlot peut en changer sans avancer ni reculer dans le temps
+        if (m_lod.enabled && m_lodStep % LodInterval == 0) {
+            UpdateLod();
+        }
+
+        // Corps éveillés en tête des tableaux : les corps endormis ne coûtent rien
+        if (m_layoutDirty) {
+            PartitionAwakeBodies();
+            GatherAwakeConstraints();
+            m_layoutDirty = false;
+        }
+
+        // Position au début du pas, pour l'interpolation du rendu
+        std::copy_n(m_bodies.posX.begin(), m_awakeCount, m_bodies.prevPosX.begin());
+        std::copy_n(m_bodies.posY.begin(), m_awakeCount, m_bodies.prevPosY.begin());
+        std::copy_n(m_bodies.posZ.begin(), m_awakeCount, m_bodies.prevPosZ.begin());
+        SetIdleSlots(passes, passCount, true);
     }
-    
-    // Intégration des vélocités
-    for (auto& body : m_bodies) {
-        if (!body->isKinematic) {
-            IntegrateVelocity(*body, deltaTime);
+
+    // Chaque créneau actif avance de son propre pas de temps ; les îlots
+    // sont indépendants, l'ordre des créneaux n'y change rien
+    m_solverStats.iterations = 0;
+    m_solverStats.residualError = 0.0f;
+    for (size_t p = 0; p < passCount; ++p) {
+        const uint32_t slot = passes[p].slot;
+        const float slotDelta = deltaTime * passes[p].scale;
+        if (slot > 0 && m_lodOffsets[slot] == m_lodOffsets[slot + 1]) continue;
+
+        if (m_solverMode == SolverMode::Xpbd) {
+            StepXpbd(slotDelta, slot);
+        } else {
+            // Intégration des forces
+            IntegrateForces(slotDelta, slot);
+
+            // Résoudre les contraintes (articulations)
+            SolveConstraintPasses(slot);
+
+            // Intégration des vélocités
+            IntegrateVelocity(slotDelta, slot);
         }
     }
-    
+
     // Collisions
-    HandleCollisions();
-    
-    // Reset des forces
-    for (auto& body : m_bodies) {
-        body->force = glm::vec3(0.0f);
-    }
-}
-
-void PhysicsEngine::IntegrateForces(RigidBody& body, float deltaTime) {
-    if (body.mass <= 0.0f) return;
-    
-    // Ajouter la gravité
-    if (body.useGravity) {
-        body.force += m_gravity * body.mass;
-    }
-    
-    // Calculer l'accélération (F = ma)
-    body.acceleration = body.force / body.mass;
-    
-    // Mettre à jour la vélocité
-    body.velocity += body.acceleration * deltaTime;
-    
-    // Friction aérienne simple
-    body.velocity *= 0.995f;
-}
-
-void PhysicsEngine::IntegrateVelocity(RigidBody& body, float deltaTime) {
-    body.position += body.velocity * deltaTime;
-    
-    // Friction au sol (simple)
-    if (body.position.y <= body.boxMin.y + 0.01f) {
-        body.velocity.x *= (1.0f - body.friction * deltaTime * 10.0f);
-        body.velocity.z *= (1.0f - body.friction * deltaTime * 10.0f);
-    }
-}
-
-void PhysicsEngine::SolveConstraints() {
-    for (auto& constraint : m_constraints) {
-        if (!constraint.bodyA || !constraint.bodyB) continue;
-        
+    HandleCollisions(deltaTime, passes, passCount);
+    SetIdleSlots(passes, passCount, false);
+    m_lodStep++;
+
+    // Endormir les îlots restés calmes assez longtemps
+    WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Sleep);
+    if (m_sleepingEnabled && m_islands.UpdateSleep(m_bodies, deltaTime, m_sleepEnergy, m_sleepSteps)) {
+        m_layoutDirty = true;
+        if (!m_oriented.empty()) WakeNearOriented();
+    }
+}
+
+size_t PhysicsEngine::GetLodPasses(LodPasses& passes) const {
+    // Plein régime, puis la phase courante du demi et du quart de régime
+    passes[0] = {0, 1.0f};
+    if (!m_lod.enabled) return 1;
+    passes[1] = {1 + m_lodStep % 2, 2.0f};
+    passes[2] = {3 + m_lodStep % 4, 4.0f};
+    return 3;
+}
+
+void PhysicsEngine::SetIdleSlots(const LodPasses& passes, size_t passCount, bool idle) {
+    if (passCount == 1) return;
+    for (uint32_t slot = 1; slot < LodSlots; ++slot) {
+        if (slot == passes[1].slot || slot == passes[2].slot) continue;
+        for (uint32_t i = m_lodOffsets[slot]; i < m_lodOffsets[slot + 1]; ++i) {
+            if (idle) {
+                m_bodies.flags[i] |= BodyFlag_Idle;
+            } else {
+                m_bodies.flags[i] &= ~BodyFlag_Idle;
+            }
+        }
+    }
+}
+
+void PhysicsEngine::UpdateLod() {
+    const float hysteresis = m_lod.hysteresis;
+    const float distances[3] = {m_lod.halfRateDistance, m_lod.quarterRateDistance, m_lod.freezeDistance};
+    // Niveau (0 plein régime .. 3 gelé) pour une distance au carré, chaque
+    // seuil décalé de offset
+    auto levelAt = [&](float distanceSq, float offset) {
+        int level = 0;
+        for (float distance : distances) {
+            float threshold = std::max(distance + offset, 0.0f);
+            level += distanceSq > threshold * threshold ? 1 : 0;
+        }
+        return level;
+    };
+
+    bool changed = false;
+    m_lodStats = LodStats();
+    m_islands.ForEachAwakeIsland([&](const BodyHandle* members, size_t count) {
+        // Distance de l'îlot : celle de son corps le plus proche
+        float distanceSq = std::numeric_limits<float>::max();
+        for (size_t m = 0; m < count; ++m) {
+            glm::vec3 offset = m_bodies.Position(m_bodies.DenseIndex(members[m])) - m_lodFocus;
+            distanceSq = std::min(distanceSq, glm::dot(offset, offset));
+        }
+
+        uint32_t first = m_bodies.DenseIndex(members[0]);
+        int level = m_bodies.IsFrozen(first) ? 3 : m_bodies.lod[first] >= 3 ? 2 : m_bodies.lod[first] >= 1 ? 1 : 0;
+        // S'éloigner : directement au niveau atteint ; se rapprocher : un
+        // niveau par évaluation, pour que l'îlot reprenne en douceur
+        int farther = levelAt(distanceSq, hysteresis);
+        if (farther > level) {
+            level = farther;
+        } else if (levelAt(distanceSq, -hysteresis) < level) {
+            level--;
+        }
+
+        // Phase tirée du handle (hachage) : les îlots d'un même régime se
+        // répartissent sur les pas, même si leurs handles se suivent
+        uint32_t phase = (members[0].index * 2654435761u) >> 30;
+        uint8_t slot = static_cast<uint8_t>(level == 1 ? 1 + phase % 2 : level == 2 ? 3 + phase : 0);
+        bool frozen = level == 3;
+
+        for (size_t m = 0; m < count; ++m) {
+            uint32_t i = m_bodies.DenseIndex(members[m]);
+            if (m_bodies.lod[i] == slot && m_bodies.IsFrozen(i) == frozen) continue;
+            m_bodies.lod[i] = slot;
+            if (frozen) {
+                // Immobile jusqu'au dégel, sans interpolation résiduelle
+                m_bodies.flags[i] |= BodyFlag_Frozen;
+                m_bodies.SetPreviousPosition(i, m_bodies.Position(i));
+            } else {
+                m_bodies.flags[i] &= ~BodyFlag_Frozen;
+            }
+            changed = true;
+        }
+
+        size_t* counters[4] = {&m_lodStats.fullRateBodies, &m_lodStats.halfRateBodies,
+                               &m_lodStats.quarterRateBodies, &m_lodStats.frozenBodies};
+        *counters[level] += count;
+    });
+
+    if (changed) m_layoutDirty = true;
+}
+
+void PhysicsEngine::WakeNearOriented() {
+    // Une boîte orientée statique tourne sans que le BVH le voie : rien ne
+    // doit s'endormir à sa portée. Les îlots qui viennent de s'endormir sont
+    // encore dans la zone éveillée ; rare, un simple parcours suffit.
+    for (uint32_t i = 0; i < m_awakeCount; ++i) {
+        if (!m_bodies.IsSleeping(i)) continue;
+
+        bool touching = false;
+        glm::vec3 position = m_bodies.Position(i);
+        glm::vec3 margin(ContactSolver::Margin);
+        m_staticGeometry.Query(position + m_bodies.BoxMin(i) - margin, position + m_bodies.BoxMax(i) + margin,
+            [&](BodyHandle shape) {
+                touching = touching || (m_bodies.flags[m_bodies.DenseIndex(shape)] & BodyFlag_Oriented) != 0;
+            });
+        if (touching) WakeDense(i);
+    }
+}
+
+void PhysicsEngine::IntegrateForces(float deltaTime, uint32_t slot) {
+    WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::IntegrateForces);
+    // Gravité, F = ma et friction aérienne sur tous les corps du créneau à la fois
+    IntegrateForcesBatch(m_bodies, m_lodOffsets[slot], m_lodOffsets[slot + 1], m_gravity, deltaTime, m_simdLevel);
+}
+
+void PhysicsEngine::IntegrateVelocity(float deltaTime, uint32_t slot) {
+    WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::IntegrateVelocity);
+    // Position + friction au sol (simple)
+    IntegrateVelocityBatch(m_bodies, m_lodOffsets[slot], m_lodOffsets[slot + 1], deltaTime, m_simdLevel);
+}
+
+void PhysicsEngine::RebuildIslands() {
+    std::vector<IslandManager::Link> links;
+    links.reserve(m_constraints.size());
+    for (const auto& constraint : m_constraints) {
+        links.emplace_back(constraint.bodyA, constraint.bodyB);
+    }
+    for (const auto& group : m_skeletons) {
+        for (size_t first = 0; first < group.bodies.size(); first += group.partCount) {
+            for (const auto& joint : group.joints) {
+                links.emplace_back(group.bodies[first + joint.parent], group.bodies[first + joint.child]);
+            }
+        }
+    }
+    m_islands.Build(m_bodies, links);
+    m_layoutDirty = true;
+}
+
+void PhysicsEngine::PartitionAwakeBodies() {
+    // Les corps éveillés (et cinématiques animés) d'abord, les corps endormis
+    // et statiques ensuite. Les handles restent valides ; seuls les indices
+    // denses changent.
+    const uint8_t inactive = BodyFlag_Sleeping | BodyFlag_Frozen | BodyFlag_Static;
+    uint32_t first = 0;
+    uint32_t last = static_cast<uint32_t>(m_bodies.Size());
+    for (;;) {
+        while (first < last && !(m_bodies.flags[first] & inactive)) ++first;
+        while (first < last && (m_bodies.flags[last - 1] & inactive)) --last;
+        if (first >= last) break;
+        m_bodies.Swap(first, last - 1);
+    }
+    m_awakeCount = first;
+
+    // Puis les corps éveillés par créneau LOD (tout au créneau 0 sans LOD)
+    m_lodOffsets[0] = 0;
+    std::fill(m_lodOffsets + 1, m_lodOffsets + LodSlots + 1, m_awakeCount);
+    if (!m_lod.enabled) return;
+    for (uint32_t slot = 0; slot + 1 < LodSlots; ++slot) {
+        first = m_lodOffsets[slot];
+        last = m_awakeCount;
+        for (;;) {
+            while (first < last && m_bodies.lod[first] == slot) ++first;
+            while (first < last && m_bodies.lod[last - 1] != slot) --last;
+            if (first >= last) break;
+            m_bodies.Swap(first, last - 1);
+        }
+        m_lodOffsets[slot + 1] = first;
+    }
+}
+
+void PhysicsEngine::GatherAwakeConstraints() {
+    // Les deux corps d'une contrainte sont dans le même îlot (ou l'un est
+    // cinématique, toujours au créneau 0) : une contrainte dort dès que l'un
+    // de ses corps dort, et suit le créneau le plus élevé des deux
+    const uint8_t inactive = BodyFlag_Sleeping | BodyFlag_Frozen;
+    const uint32_t slots = m_lod.enabled ? LodSlots : 1;
+    m_awakeConstraints.clear();
+    m_constraintDense.clear();
+    m_awakeOffsets.assign(1, 0);
+    std::fill(std::begin(m_awakeJoints), std::end(m_awakeJoints), 0);
+
+    for (size_t batch = 0; batch + 1 < m_colorOffsets.size(); ++batch) {
+        for (uint32_t slot = 0; slot < LodSlots; ++slot) {
+            for (size_t c = m_colorOffsets[batch]; c < m_colorOffsets[batch + 1] && slot < slots; ++c) {
+                uint32_t a = m_bodies.DenseIndex(m_constraints[c].bodyA);
+                uint32_t b = m_bodies.DenseIndex(m_constraints[c].bodyB);
+                if ((m_bodies.flags[a] | m_bodies.flags[b]) & inactive) continue;
+                if (std::max(m_bodies.lod[a], m_bodies.lod[b]) != slot && slots > 1) continue;
+
+                m_awakeConstraints.push_back(static_cast<uint32_t>(c));
+                m_constraintDense.push_back(a);
+                m_constraintDense.push_back(b);
+                m_awakeJoints[slot]++;
+            }
+            m_awakeOffsets.push_back(m_awakeConstraints.size());
+        }
+    }
+
+    // Squelettes : de même, un squelette dort dès que l'une de ses parties dort.
+    // Les masses inverses ne changent qu'avec la disposition : calculées ici.
+    auto skeletonSlot = [this](auto parts, size_t partCount) {
+        uint8_t slot = 0;
+        for (size_t p = 0; p < partCount; ++p) slot = std::max(slot, m_bodies.lod[m_bodies.DenseIndex(parts[p])]);
+        return slot;
+    };
+    for (auto& group : m_skeletons) {
+        group.awakeDense.clear();
+        group.awakeInverseMass.clear();
+        group.awakeSlots.assign(1, 0);
+        for (uint32_t slot = 0; slot < LodSlots; ++slot) {
+            for (size_t first = 0; first < group.bodies.size() && slot < slots; first += group.partCount) {
+                auto parts = group.bodies.begin() + first;
+                if (std::any_of(parts, parts + group.partCount, [this, inactive](BodyHandle body) {
+                        return (m_bodies.flags[m_bodies.DenseIndex(body)] & inactive) != 0;
+                    })) {
+                    continue;
+                }
+                if (slots > 1 && skeletonSlot(parts, group.partCount) != slot) continue;
+                for (size_t p = 0; p < group.partCount; ++p) {
+                    uint32_t i = m_bodies.DenseIndex(group.bodies[first + p]);
+                    group.awakeDense.push_back(i);
+                    group.awakeInverseMass.push_back(m_bodies.IsKinematic(i) ? 0.0f : 1.0f / m_bodies.mass[i]);
+                }
+                m_awakeJoints[slot]++;
+            }
+            group.awakeSlots.push_back(group.awakeDense.size() / group.partCount);
+        }
+    }
+}
+
+void PhysicsEngine::PurgeDeadConstraints() {
+    m_constraints.erase(
+        std::remove_if(m_constraints.begin(), m_constraints.end(),
+            [this](const Constraint& c) {
+                return !m_bodies.IsAlive(c.bodyA) || !m_bodies.IsAlive(c.bodyB);
+            }),
+        m_constraints.end()
+    );
+
+    // Un squelette qui a perdu une partie disparaît en entier
+    for (auto& group : m_skeletons) {
+        size_t kept = 0;
+        for (size_t first = 0; first < group.bodies.size(); first += group.partCount) {
+            bool alive = std::all_of(group.bodies.begin() + first, group.bodies.begin() + first + group.partCount,
+                                     [this](BodyHandle body) { return m_bodies.IsAlive(body); });
+            if (!alive) continue;
+            std::copy_n(group.bodies.begin() + first, group.partCount, group.bodies.begin() + kept);
+            kept += group.partCount;
+        }
+        group.bodies.resize(kept);
+    }
+    m_hasDeadConstraints = false;
+    m_constraintsDirty = true;
+}
+
+void PhysicsEngine::ColorConstraints() {
+    // Coloration gloutonne : chaque contrainte prend la plus petite couleur
+    // qu'aucune autre contrainte de ses deux corps n'utilise encore.
+    // Au-delà de 64 couleurs, les contraintes vont dans un lot résolu en série.
+    const size_t MAX_COLORS = 64;
+    std::vector<uint64_t> usedColors(m_bodies.SlotCount(), 0);
+    std::vector<uint8_t> colors(m_constraints.size());
+    std::vector<size_t> batchSizes(MAX_COLORS + 1, 0);
+
+    for (size_t c = 0; c < m_constraints.size(); ++c) {
+        uint32_t a = m_constraints[c].bodyA.index;
+        uint32_t b = m_constraints[c].bodyB.index;
+        uint64_t used = usedColors[a] | usedColors[b];
+
+        size_t color = MAX_COLORS;
+        if (used != ~0ull) {
+            color = 0;
+            while (used & (1ull << color)) ++color;
+            usedColors[a] |= 1ull << color;
+            usedColors[b] |= 1ull << color;
+        }
+        colors[c] = static_cast<uint8_t>(color);
+        batchSizes[color]++;
+    }
+
+    // Regrouper les contraintes par couleur (tri stable : ordre d'ajout conservé)
+    size_t colorCount = 0;
+    for (size_t color = 0; color < MAX_COLORS; ++color) {
+        if (batchSizes[color] > 0) colorCount = color + 1;
+    }
+
+    std::vector<size_t> offsets(MAX_COLORS + 2, 0);
+    for (size_t color = 0; color <= MAX_COLORS; ++color) {
+        offsets[color + 1] = offsets[color] + batchSizes[color];
+    }
+
+    std::vector<Constraint> sorted(m_constraints);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t c = 0; c < m_constraints.size(); ++c) {
+        sorted[cursor[colors[c]]++] = m_constraints[c];
+    }
+    m_constraints.swap(sorted);
+
+    m_colorOffsets.assign(offsets.begin(), offsets.begin() + colorCount + 1);
+    m_serialBatch = colorCount;
+    if (batchSizes[MAX_COLORS] > 0) {
+        m_colorOffsets.push_back(m_constraints.size());
+    }
+    m_constraintsDirty = false;
+}
+
+void PhysicsEngine::RebuildJointFilter() {
+    m_jointedPairs.Clear();
+    for (const auto& constraint : m_constraints) {
+        m_jointedPairs.Set(JointKey(constraint.bodyA, constraint.bodyB), 0);
+    }
+    for (const auto& group : m_skeletons) {
+        for (size_t first = 0; first < group.bodies.size(); first += group.partCount) {
+            for (const auto& joint : group.joints) {
+                m_jointedPairs.Set(JointKey(group.bodies[first + joint.parent], group.bodies[first + joint.child]), 0);
+            }
+        }
+    }
+}
+
+void PhysicsEngine::SolveConstraintPasses(uint32_t slot) {
+    WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Constraints);
+    using Clock = std::chrono::steady_clock;
+
+    int iterations = 0;
+    float error = 0.0f;
+    bool outOfTime = false;
+    if (HasAwakeJoints(slot)) {
+        const bool timed = m_solverTimeBudget > 0.0f && !m_deterministic;
+        const Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+
+        while (iterations < m_maxIterations) {
+            error = SolveConstraints(slot);
+            ++iterations;
+            if (iterations < m_minIterations) continue;
+            if (error <= m_solverTolerance) break;
+            if (timed && std::chrono::duration<float, std::micro>(Clock::now() - start).count() >= m_solverTimeBudget) {
+                outOfTime = true;
+                break;
+            }
+        }
+    }
+
+    // Plusieurs créneaux par pas : le plus exigeant
+    m_solverStats.iterations = std::max(m_solverStats.iterations, iterations);
+    m_solverStats.totalIterations += iterations;
+    m_solverStats.residualError = std::max(m_solverStats.residualError, error);
+    // Hors tolérance : soit le temps, soit les passes ont manqué
+    if (outOfTime) {
+        m_solverStats.budgetStops++;
+    } else if (error > m_solverTolerance) {
+        m_solverStats.iterationLimitStops++;
+    }
+}
+
+void PhysicsEngine::StepXpbd(float deltaTime, uint32_t slot) {
+    const int substeps = m_xpbdSubsteps;
+    const float h = deltaTime / static_cast<float>(substeps);
+    // Même friction aérienne par pas qu'en mode itératif
+    const float damping = std::pow(AIR_DAMPING, 1.0f / static_cast<float>(substeps));
+    const uint32_t begin = m_lodOffsets[slot];
+    const uint32_t end = m_lodOffsets[slot + 1];
+    m_substepDelta = h;
+
+    if (m_substepX.size() < m_awakeCount) {
+        m_substepX.resize(m_awakeCount);
+        m_substepY.resize(m_awakeCount);
+        m_substepZ.resize(m_awakeCount);
+    }
+
+    float error = 0.0f;
+    for (int substep = 0; substep < substeps; ++substep) {
+        {
+            WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::IntegrateForces);
+            IntegrateForcesBatch(m_bodies, begin, end, m_gravity, h, m_simdLevel, damping);
+        }
+        {
+            WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::IntegrateVelocity);
+            IntegrateVelocityBatch(m_bodies, begin, end, h, m_simdLevel);
+        }
+        if (!HasAwakeJoints(slot)) continue;
+
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Constraints);
+        std::copy(m_bodies.posX.begin() + begin, m_bodies.posX.begin() + end, m_substepX.begin() + begin);
+        std::copy(m_bodies.posY.begin() + begin, m_bodies.posY.begin() + end, m_substepY.begin() + begin);
+        std::copy(m_bodies.posZ.begin() + begin, m_bodies.posZ.begin() + end, m_substepZ.begin() + begin);
+
+        error = SolveConstraints(slot);
+
+        // Le déplacement imposé par les contraintes devient de la vitesse
+        // (la friction au sol déjà appliquée à v est conservée)
+        const float inverseH = 1.0f / h;
+        for (uint32_t i = begin; i < end; ++i) {
+            m_bodies.velX[i] += (m_bodies.posX[i] - m_substepX[i]) * inverseH;
+            m_bodies.velY[i] += (m_bodies.posY[i] - m_substepY[i]) * inverseH;
+            m_bodies.velZ[i] += (m_bodies.posZ[i] - m_substepZ[i]) * inverseH;
+        }
+    }
+
+    int passes = HasAwakeJoints(slot) ? substeps : 0;
+    m_solverStats.iterations = std::max(m_solverStats.iterations, passes);
+    m_solverStats.totalIterations += passes;
+    m_solverStats.residualError = std::max(m_solverStats.residualError, error);
+}
+
+float PhysicsEngine::SolveConstraints(uint32_t slot) {
+    // En dessous de cette taille, répartir un lot coûte plus que le résoudre
+    const size_t MIN_PARALLEL_BATCH = 64;
+
+    float maxError = 0.0f;
+
+    for (size_t batch = 0; batch * LodSlots + 1 < m_awakeOffsets.size(); ++batch) {
+        size_t begin = m_awakeOffsets[batch * LodSlots + slot];
+        size_t end = m_awakeOffsets[batch * LodSlots + slot + 1];
+
+        // Aucun corps n'apparaît deux fois dans un lot : l'ordre de résolution
+        // n'y change rien, le résultat est le même quel que soit le découpage
+        if (m_threadPool && batch < m_serialBatch && end - begin >= MIN_PARALLEL_BATCH) {
+            // Le maximum ne dépend pas de l'ordre : le découpage n'y change rien
+            std::atomic<float> batchError{0.0f};
+            m_threadPool->ParallelFor(end - begin, [this, begin, &batchError](size_t first, size_t last) {
+                ScopedFloatEnvironment floatEnvironment(m_deterministic);
+                float chunkError = m_solverMode == SolverMode::Xpbd ? SolveXpbdRange(begin + first, begin + last)
+                                                                    : SolveConstraintRange(begin + first, begin + last);
+                float current = batchError.load();
+                while (chunkError > current && !batchError.compare_exchange_weak(current, chunkError)) {}
+            });
+            maxError = std::max(maxError, batchError.load());
+        } else {
+            maxError = std::max(maxError, m_solverMode == SolverMode::Xpbd ? SolveXpbdRange(begin, end)
+                                                                           : SolveConstraintRange(begin, end));
+        }
+    }
+    return std::max(maxError, SolveSkeletonGroups(slot));
+}
+
+float PhysicsEngine::SolveSkeletonGroups(uint32_t slot) {
+    // Un squelette vaut environ huit contraintes
+    const size_t MIN_PARALLEL_SKELETONS = 8;
+
+    SkeletonSolveParams params;
+    params.xpbd = m_solverMode == SolverMode::Xpbd;
+    params.complianceScale = params.xpbd ? 1.0f / (m_substepDelta * m_substepDelta) : 0.0f;
+
+    float maxError = 0.0f;
+    for (auto& group : m_skeletons) {
+        // Squelettes du créneau
+        const size_t partCount = group.partCount;
+        const size_t count = group.awakeSlots[slot + 1] - group.awakeSlots[slot];
+        const uint32_t* dense = group.awakeDense.data() + group.awakeSlots[slot] * partCount;
+        const float* inverseMass = group.awakeInverseMass.data() + group.awakeSlots[slot] * partCount;
+        if (count == 0) continue;
+
+        // Les squelettes ne partagent aucun corps : même résultat quel que soit le découpage
+        if (m_threadPool && count >= MIN_PARALLEL_SKELETONS) {
+            std::atomic<float> groupError{0.0f};
+            m_threadPool->ParallelFor(count, [&, partCount, dense, inverseMass](size_t first, size_t last) {
+                ScopedFloatEnvironment floatEnvironment(m_deterministic);
+                float chunkError = group.solve(m_bodies, dense + first * partCount, inverseMass + first * partCount,
+                                               last - first, params);
+                float current = groupError.load();
+                while (chunkError > current && !groupError.compare_exchange_weak(current, chunkError)) {}
+            });
+            maxError = std::max(maxError, groupError.load());
+        } else {
+            maxError = std::max(maxError, group.solve(m_bodies, dense, inverseMass, count, params));
+        }
+    }
+    return maxError;
+}
+
+float PhysicsEngine::SolveConstraintRange(size_t begin, size_t end) {
+    float maxError = 0.0f;
+    for (size_t k = begin; k < end; ++k) {
+        const Constraint& constraint = m_constraints[m_awakeConstraints[k]];
+        uint32_t a = m_constraintDense[k * 2];
+        uint32_t b = m_constraintDense[k * 2 + 1];
+
         // Calculer la différence de position
-        glm::vec3 delta = constraint.bodyB->position - constraint.bodyA->position;
+        glm::vec3 delta = m_bodies.Position(b) - m_bodies.Position(a);
         float distance = glm::length(delta);
-        
+
         if (distance < 0.0001f) continue;
-        
+
         // Calculer la correction
         float error = distance - constraint.restLength;
         glm::vec3 correction = (delta / distance) * error * constraint.stiffness;
-        
+
         // Appliquer la correction (50/50 si les deux bougent)
-        if (!constraint.bodyA->isKinematic && !constraint.bodyB->isKinematic) {
-            constraint.bodyA->position += correction * 0.5f;
-            constraint.bodyB->position -= correction * 0.5f;
-        } else if (!constraint.bodyA->isKinematic) {
-            constraint.bodyA->position += correction;
-        } else if (!constraint.bodyB->isKinematic) {
-            constraint.bodyB->position -= correction;
-        }
-    }
-}
-
-bool PhysicsEngine::CheckCollision(const RigidBody& a, const RigidBody& b) {
-    glm::vec3 aMin = a.position + a.boxMin;
-    glm::vec3 aMax = a.position + a.boxMax;
-    glm::vec3 bMin = b.position + b.boxMin;
-    glm::vec3 bMax = b.position + b.boxMax;
-    
-    return (aMin.x <= bMax.x && aMax.x >= bMin.x) &&
-           (aMin.y <= bMax.y && aMax.y >= bMin.y) &&
-           (aMin.z <= bMax.z && aMax.z >= bMin.z);
-}
-
-void PhysicsEngine::ResolveCollision(RigidBody& a, RigidBody& b) {
-    // Calculer la normale de collision
-    glm::vec3 normal = glm::normalize(b.position - a.position);
-    
-    // Vélocité relative
-    glm::vec3 relativeVel = b.velocity - a.velocity;
-    float velAlongNormal = glm::dot(relativeVel, normal);
-    
-    // Ne pas résoudre si les objets s'éloignent
-    if (velAlongNormal > 0) return;
-    
-    // Calculer l'impulsion
-    float restitution = std::min(a.restitution, b.restitution);
-    float impulseMagnitude = -(1.0f + restitution) * velAlongNormal;
-    impulseMagnitude /= (1.0f / a.mass + 1.0f / b.mass);
-    
-    glm::vec3 impulse = impulseMagnitude * normal;
-    
-    // Appliquer l'impulsion
-    if (!a.isKinematic) a.velocity -= impulse / a.mass;
-    if (!b.isKinematic) b.velocity += impulse / b.mass;
-}
-
-void PhysicsEngine::HandleCollisions() {
-    // Collision simple avec le sol
-    for (auto& body : m_bodies) {
-        if (body->isKinematic) continue;
-        
-        float groundY = 0.0f;
-        float bodyBottom = body->position.y + body->boxMin.y;
-        
-        if (bodyBottom < groundY) {
-            body->position.y = groundY - body->boxMin.y;
-            
-            // Rebond
-            if (body->velocity.y < 0) {
-                body->velocity.y *= -body->restitution;
-                
-                // Arrêter de rebondir si trop lent
-                if (std::abs(body->velocity.y) < 0.1f) {
-                    body->velocity.y = 0.0f;
+        bool kinematicA = m_bodies.IsKinematic(a);
+        bool kinematicB = m_bodies.IsKinematic(b);
+        if (!kinematicA || !kinematicB) {
+            maxError = std::max(maxError, std::abs(error));
+        }
+        if (!kinematicA && !kinematicB) {
+            m_bodies.SetPosition(a, m_bodies.Position(a) + correction * 0.5f);
+            m_bodies.SetPosition(b, m_bodies.Position(b) - correction * 0.5f);
+        } else if (!kinematicA) {
+            m_bodies.SetPosition(a, m_bodies.Position(a) + correction);
+        } else if (!kinematicB) {
+            m_bodies.SetPosition(b, m_bodies.Position(b) - correction);
+        }
+    }
+    return maxError;
+}
+
+float PhysicsEngine::SolveXpbdRange(size_t begin, size_t end) {
+    // Une seule passe par sous-pas : le multiplicateur repart de 0,
+    // dlambda = -C / (wA + wB + compliance / h²)
+    const float complianceScale = 1.0f / (m_substepDelta * m_substepDelta);
+
+    float maxError = 0.0f;
+    for (size_t k = begin; k < end; ++k) {
+        const Constraint& constraint = m_constraints[m_awakeConstraints[k]];
+        uint32_t a = m_constraintDense[k * 2];
+        uint32_t b = m_constraintDense[k * 2 + 1];
+
+        float weightA = m_bodies.IsKinematic(a) ? 0.0f : 1.0f / m_bodies.mass[a];
+        float weightB = m_bodies.IsKinematic(b) ? 0.0f : 1.0f / m_bodies.mass[b];
+        float weightSum = weightA + weightB;
+        if (weightSum <= 0.0f) continue;
+
+        glm::vec3 delta = m_bodies.Position(b) - m_bodies.Position(a);
+        float distance = glm::length(delta);
+        if (distance < 0.0001f) continue;
+
+        float error = distance - constraint.restLength;
+        maxError = std::max(maxError, std::abs(error));
+
+        float lambda = -error / (weightSum + constraint.compliance * complianceScale);
+        glm::vec3 correction = (delta / distance) * lambda;
+        m_bodies.SetPosition(a, m_bodies.Position(a) - correction * weightA);
+        m_bodies.SetPosition(b, m_bodies.Position(b) + correction * weightB);
+    }
+    return maxError;
+}
+
+bool PhysicsEngine::CheckCollision(BodyHandle a, BodyHandle b) const {
+    if (!m_bodies.IsAlive(a) || !m_bodies.IsAlive(b)) return false;
+    uint32_t i = m_bodies.DenseIndex(a);
+    uint32_t j = m_bodies.DenseIndex(b);
+    if ((m_bodies.flags[i] | m_bodies.flags[j]) & BodyFlag_Oriented) {
+        Contact contact;
+        return MeasureOriented(i, j, 0.0f, contact);
+    }
+    return CheckCollisionDense(i, j);
+}
+
+void PhysicsEngine::ResolveCollision(BodyHandle a, BodyHandle b) {
+    if (!m_bodies.IsAlive(a) || !m_bodies.IsAlive(b)) return;
+
+    uint32_t i = m_bodies.DenseIndex(a);
+    uint32_t j = m_bodies.DenseIndex(b);
+    Contact contact;
+    bool touching = (m_bodies.flags[i] | m_bodies.flags[j]) & BodyFlag_Oriented
+                        ? MeasureOriented(i, j, 0.0f, contact)
+                        : ContactSolver::Measure(m_bodies, i, j, 0.0f, contact);
+    if (!touching) return;
+    ContactSolver::PrepareContact(m_bodies, contact, 0.0f);
+    ContactSolver::SolveContact(m_bodies, contact);
+}
+
+void PhysicsEngine::MarkQueryIndexDirty(bool rebuild) {
+    m_queryRebuild = m_queryRebuild || rebuild;
+    m_queryDirty.store(true, std::memory_order_relaxed);
+}
+
+void PhysicsEngine::RefreshQueryIndex() const {
+    // Le premier thread qui interroge le moteur après un pas met l'index à
+    // jour ; les suivants n'ont plus qu'une lecture atomique
+    if (!m_queryDirty.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(m_queryMutex);
+    if (!m_queryDirty.load(std::memory_order_relaxed)) return;
+
+    if (m_queryRebuild) {
+        m_queryIndex.Rebuild(m_bodies);
+        m_queryRebuild = false;
+    } else {
+        m_queryIndex.Refresh(m_bodies);
+    }
+    m_queryDirty.store(false, std::memory_order_release);
+}
+
+bool PhysicsEngine::CastClosest(const glm::vec3& origin, const glm::vec3& delta, const glm::vec3& expand,
+                                float maxT, const QueryFilter& filter, BodyHandle& body, float& t,
+                                glm::vec3& normal) const {
+    // maxT suit le plus proche impact : le reste du parcours ne garde que
+    // ce qui le précède strictement
+    const Segment segment(origin, delta);
+    bool found = false;
+    auto closest = [&](BodyHandle candidate, float candidateT, int candidateAxis) {
+        if (filter.Ignores(candidate) || (found && candidateT >= maxT)) return;
+
+        // Boîte orientée : son AABB englobante n'était qu'un premier tri
+        glm::vec3 candidateNormal;
+        uint32_t i = m_bodies.DenseIndex(candidate);
+        if (m_bodies.flags[i] & BodyFlag_Oriented) {
+            if (!CastOriented(i, origin, delta, expand, maxT, candidateT, candidateNormal)) return;
+        } else {
+            candidateNormal = EntryNormal(delta, candidateAxis);
+        }
+
+        found = true;
+        maxT = candidateT;
+        body = candidate;
+        t = candidateT;
+        normal = candidateNormal;
+    };
+
+    if (filter.staticBodies) {
+        if (!m_staticDirty) {
+            m_staticGeometry.Cast(segment, expand, maxT, closest);
+        } else {
+            for (BodyHandle shape : m_staticBodies) {
+                uint32_t i = m_bodies.DenseIndex(shape);
+                glm::vec3 position = m_bodies.Position(i);
+                float shapeT = 0.0f;
+                int shapeAxis = -1;
+                if (IntersectSegmentBox(segment, maxT, position + m_bodies.BoxMin(i) - expand,
+                                        position + m_bodies.BoxMax(i) + expand, shapeT, shapeAxis)) {
+                    closest(shape, shapeT, shapeAxis);
                 }
             }
         }
     }
-    
-    // Collisions entre corps
-    for (size_t i = 0; i < m_bodies.size(); ++i) {
-        for (size_t j = i + 1; j < m_bodies.size(); ++j) {
-            if (CheckCollision(*m_bodies[i], *m_bodies[j])) {
-                ResolveCollision(*m_bodies[i], *m_bodies[j]);
+    if (filter.dynamicBodies) {
+        RefreshQueryIndex();
+        m_queryIndex.Cast(segment, expand, maxT, closest);
+    }
+
+    // Sol (HandleCollisions) : solide sous la surface du terrain
+    float groundT = 0.0f;
+    if (filter.ground && m_terrain.Cast(origin, delta, expand.y, maxT, groundT) && !(found && groundT >= maxT)) {
+        found = true;
+        body = BodyHandle();
+        t = groundT;
+    }
+    return found;
+}
+
+bool PhysicsEngine::CastOriented(uint32_t i, const glm::vec3& origin, const glm::vec3& delta, const glm::vec3& expand,
+                                 float maxT, float& t, glm::vec3& normal) const {
+    const OrientedBody& oriented = m_oriented[m_orientedIndex.Find(m_bodies.HandleAt(i).index)];
+    OrientedBox box = WorldBox(oriented);
+
+    // Segment dans le repère de la boîte ; l'élargissement (demi-taille
+    // balayée) est projeté sur chacun de ses axes
+    glm::vec3 offset = origin - box.center;
+    glm::vec3 localOrigin, localDelta, reach;
+    for (int k = 0; k < 3; ++k) {
+        localOrigin[k] = glm::dot(offset, box.axes[k]);
+        localDelta[k] = glm::dot(delta, box.axes[k]);
+        reach[k] = box.halfExtents[k] + glm::dot(glm::abs(box.axes[k]), expand);
+    }
+
+    int axis = -1;
+    if (!IntersectSegmentBox(Segment(localOrigin, localDelta), maxT, -reach, reach, t, axis)) return false;
+    normal = axis < 0 ? EntryNormal(delta, axis) : box.axes[axis] * (localDelta[axis] > 0.0f ? -1.0f : 1.0f);
+    return true;
+}
+
+bool PhysicsEngine::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                            RaycastHit& hit, const QueryFilter& filter) const {
+    float length = glm::length(direction);
+    if (!(length > 0.0f) || !(maxDistance >= 0.0f)) return false;
+
+    glm::vec3 unit = direction / length;
+    BodyHandle body;
+    float t = 0.0f;
+    glm::vec3 normal(0.0f);
+    if (!CastClosest(origin, unit, glm::vec3(0.0f), maxDistance, filter, body, t, normal)) return false;
+
+    hit.body = body;
+    hit.distance = t;
+    hit.point = origin + unit * t;
+    hit.normal = body.IsValid() ? normal : m_terrain.NormalAt(hit.point.x, hit.point.z);
+    return true;
+}
+
+size_t PhysicsEngine::OverlapAABB(const glm::vec3& boxMin, const glm::vec3& boxMax, BodyHandle* results,
+                                  size_t capacity, const QueryFilter& filter) const {
+    size_t found = 0;
+    OverlapAABB(boxMin, boxMax, filter, [&](BodyHandle body) {
+        if (found < capacity) results[found] = body;
+        found++;
+    });
+    return found;
+}
+
+bool PhysicsEngine::SweepAABB(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& delta,
+                              SweepHit& hit, const QueryFilter& filter) const {
+    // Le centre de la boîte balayé contre les AABB élargies de sa demi-taille
+    glm::vec3 center = (boxMin + boxMax) * 0.5f;
+    glm::vec3 halfExtents = (boxMax - boxMin) * 0.5f;
+    BodyHandle body;
+    float t = 0.0f;
+    glm::vec3 normal(0.0f);
+    if (!CastClosest(center, delta, halfExtents, 1.0f, filter, body, t, normal)) return false;
+
+    hit.body = body;
+    hit.fraction = t;
+    if (body.IsValid()) {
+        hit.normal = normal;
+    } else {
+        glm::vec3 contact = center + delta * t;
+        hit.normal = m_terrain.NormalAt(contact.x, contact.z);
+    }
+    return true;
+}
+
+bool PhysicsEngine::CheckCollisionDense(uint32_t a, uint32_t b) const {
+    const BodyStore& s = m_bodies;
+    return (s.posX[a] + s.boxMinX[a] <= s.posX[b] + s.boxMaxX[b] &&
+            s.posX[a] + s.boxMaxX[a] >= s.posX[b] + s.boxMinX[b]) &&
+           (s.posY[a] + s.boxMinY[a] <= s.posY[b] + s.boxMaxY[b] &&
+            s.posY[a] + s.boxMaxY[a] >= s.posY[b] + s.boxMinY[b]) &&
+           (s.posZ[a] + s.boxMinZ[a] <= s.posZ[b] + s.boxMaxZ[b] &&
+            s.posZ[a] + s.boxMaxZ[a] >= s.posZ[b] + s.boxMinZ[b]);
+}
+
+Contact PhysicsEngine::OrientedContact(const OrientedBody& oriented, const OrientedBox& box, const SatAxes& axes,
+                                       uint32_t other, float depth, int axis) const {
+    glm::vec3 otherCenter = m_bodies.Position(other) + (m_bodies.BoxMin(other) + m_bodies.BoxMax(other)) * 0.5f;
+    glm::vec3 offset = otherCenter - box.center;
+    glm::vec3 normal = axes.Axis(axis);
+
+    // La boîte orientée est toujours A ; la normale va vers l'autre corps
+    Contact contact;
+    contact.bodyA = oriented.body;
+    contact.bodyB = m_bodies.HandleAt(other);
+    contact.denseA = m_bodies.DenseIndex(oriented.body);
+    contact.denseB = other;
+    contact.axis = -1;
+    contact.normal = glm::dot(offset, normal) < 0.0f ? -normal : normal;
+    contact.depth = depth;
+    contact.surfaceVelocity = glm::cross(oriented.angularVelocity, offset);
+    return contact;
+}
+
+bool PhysicsEngine::MeasureOriented(uint32_t a, uint32_t b, float margin, Contact& contact) const {
+    uint32_t box = (m_bodies.flags[a] & BodyFlag_Oriented) ? a : b;
+    uint32_t other = box == a ? b : a;
+    const OrientedBody& oriented = m_oriented[m_orientedIndex.Find(m_bodies.HandleAt(box).index)];
+
+    // Contact isolé : le même noyau, sur un lot d'une seule AABB
+    OrientedBox shape = WorldBox(oriented);
+    SatAxes axes;
+    axes.Prepare(shape);
+    AabbBatch batch;
+    batch.Add(m_bodies.Position(other) + (m_bodies.BoxMin(other) + m_bodies.BoxMax(other)) * 0.5f,
+              (m_bodies.BoxMax(other) - m_bodies.BoxMin(other)) * 0.5f);
+    float depth = 0.0f;
+    uint8_t axis = 0;
+    CollideObbBatch(shape, axes, batch, &depth, &axis, SimdLevel::Scalar);
+    if (depth < -margin) return false;
+
+    contact = OrientedContact(oriented, shape, axes, other, depth, axis);
+    return true;
+}
+
+void PhysicsEngine::DeferOriented(uint32_t a, uint32_t b, uint32_t sleeper) {
+    // Deux boîtes orientées sont cinématiques : rien à résoudre
+    bool orientedA = (m_bodies.flags[a] & BodyFlag_Oriented) != 0;
+    bool orientedB = (m_bodies.flags[b] & BodyFlag_Oriented) != 0;
+    if (orientedA && orientedB) return;
+
+    uint32_t box = orientedA ? a : b;
+    uint32_t slot = m_orientedIndex.Find(m_bodies.HandleAt(box).index);
+    std::vector<OrientedCandidate>& candidates = m_orientedCandidates[slot];
+    if (candidates.empty()) m_orientedPending.push_back(slot);
+    candidates.push_back({orientedA ? b : a, sleeper});
+}
+
+void PhysicsEngine::CollideOriented() {
+    // Seules les boîtes touchées par au moins une paire
+    for (uint32_t slot : m_orientedPending) {
+        std::vector<OrientedCandidate>& candidates = m_orientedCandidates[slot];
+
+        // Axes préparés une fois pour toute la boîte, puis toutes les AABB d'un coup
+        const OrientedBody& oriented = m_oriented[slot];
+        OrientedBox box = WorldBox(oriented);
+        m_satAxes.Prepare(box);
+        m_satBatch.Clear();
+        for (const OrientedCandidate& candidate : candidates) {
+            uint32_t j = candidate.other;
+            m_satBatch.Add(m_bodies.Position(j) + (m_bodies.BoxMin(j) + m_bodies.BoxMax(j)) * 0.5f,
+                           (m_bodies.BoxMax(j) - m_bodies.BoxMin(j)) * 0.5f);
+        }
+        m_satDepth.resize(candidates.size());
+        m_satAxis.resize(candidates.size());
+        CollideObbBatch(box, m_satAxes, m_satBatch, m_satDepth.data(), m_satAxis.data(), m_simdLevel);
+
+        for (size_t k = 0; k < candidates.size(); ++k) {
+            if (m_satDepth[k] < -ContactSolver::Margin) continue;
+            m_contacts.AddMeasured(OrientedContact(oriented, box, m_satAxes, candidates[k].other, m_satDepth[k],
+                                                   m_satAxis[k]));
+            if (candidates[k].sleeper != NoSleeper) WakeDense(candidates[k].sleeper);
+        }
+        candidates.clear();
+    }
+    m_orientedPending.clear();
+}
+
+void PhysicsEngine::HandleCollisions(float deltaTime, const LodPasses& passes, size_t passCount) {
+    const uint32_t count = static_cast<uint32_t>(m_bodies.Size());
+
+    // Collision avec le sol, en un passage vectorisé par créneau actif (corps
+    // endormis exclus : ils reposent déjà)
+    {
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Ground);
+        m_groundSpeed.resize(m_awakeCount);
+        for (size_t p = 0; p < passCount; ++p) {
+            const uint32_t begin = m_lodOffsets[passes[p].slot];
+            const uint32_t end = m_lodOffsets[passes[p].slot + 1];
+            CollideTerrainBatch(m_bodies, begin, end, m_terrain, m_groundSpeed.data(), m_simdLevel);
+
+            for (uint32_t i = begin; i < end; ++i) {
+                if (m_bodies.IsKinematic(i)) continue;
+                if (m_bodies.posY[i] + m_bodies.boxMinY[i] >= m_bodies.groundY[i] + ContactSolver::Margin) continue;
+
+                glm::vec3 normal = m_terrain.NormalAt(m_bodies.posX[i], m_bodies.posZ[i]);
+                m_contactEvents.AddGround(m_bodies, i, normal, m_groundSpeed[i] * m_bodies.mass[i]);
             }
         }
     }
+
+    // Collisions entre corps : seules les paires qui se chevauchent sur Z
+    // (sweep-and-prune) sont testées
+    {
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Broadphase);
+        m_broadphase.Update(m_bodies, ContactSolver::Margin);
+    }
+    m_contacts.Begin();
+
+    const auto& pairs = m_broadphase.GetPairs();
+    size_t bodyCount = count - m_staticBodies.size();
+    size_t allPairs = bodyCount * (bodyCount - (bodyCount > 0 ? 1 : 0)) / 2;
+
+    size_t pairsTested = 0;
+    size_t staticContacts = 0;
+    m_orientedCandidates.resize(m_oriented.size());
+    {
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::Narrowphase);
+        for (const auto& pair : pairs) {
+            uint32_t a = m_bodies.DenseIndex(pair.bodyA);
+            uint32_t b = m_bodies.DenseIndex(pair.bodyB);
+
+            // Un corps au repos (endormi, gelé ou hors de son créneau LOD)
+            // n'est touché que par un corps actif dynamique, ou par un
+            // cinématique qui vient d'être déplacé ; un îlot endormi se
+            // réveille alors. Testé avant la table des paires reliées : les
+            // paires au repos, nombreuses, s'arrêtent aux drapeaux.
+            uint32_t sleeper = NoSleeper;
+            if ((m_bodies.flags[a] | m_bodies.flags[b]) & BodyFlag_Resting) {
+                uint32_t resting = m_bodies.IsResting(a) ? a : b;
+                uint32_t other = resting == a ? b : a;
+                uint8_t otherFlags = m_bodies.flags[other];
+                if (otherFlags & BodyFlag_Resting) continue;
+                if ((otherFlags & BodyFlag_Kinematic) && !(otherFlags & BodyFlag_Moved)) continue;
+                if (m_bodies.IsSleeping(resting)) sleeper = resting;
+            }
+            uint32_t group = m_bodies.collisionGroup[a];
+            if (group != 0 && group == m_bodies.collisionGroup[b]) continue;
+            if (m_jointedPairs.Find(JointKey(pair.bodyA, pair.bodyB)) != PairIndex::NotFound) continue;
+
+            pairsTested++;
+            if ((m_bodies.flags[a] | m_bodies.flags[b]) & BodyFlag_Oriented) {
+                DeferOriented(a, b, sleeper);
+                continue;
+            }
+            if (!m_contacts.Add(m_bodies, a, b)) continue;
+            if (sleeper != NoSleeper) WakeDense(sleeper);
+        }
+
+        // Corps dynamiques actifs contre la géométrie statique. Les feuilles du
+        // BVH portent l'AABB exacte du corps : une feuille atteinte est un contact
+        // (sauf boîte orientée : son enveloppe n'est qu'un premier tri).
+        for (size_t p = 0; p < passCount; ++p) {
+            for (uint32_t i = m_lodOffsets[passes[p].slot]; i < m_lodOffsets[passes[p].slot + 1]; ++i) {
+                if (m_bodies.IsKinematic(i)) continue;
+
+                glm::vec3 position = m_bodies.Position(i);
+                glm::vec3 margin(ContactSolver::Margin);
+                m_staticGeometry.Query(position + m_bodies.BoxMin(i) - margin, position + m_bodies.BoxMax(i) + margin,
+                    [&](BodyHandle shape) {
+                        uint32_t j = m_bodies.DenseIndex(shape);
+                        if (m_bodies.flags[j] & BodyFlag_Oriented) {
+                            DeferOriented(j, i, NoSleeper);
+                        } else {
+                            m_contacts.Add(m_bodies, i, j);
+                        }
+                        staticContacts++;
+                    });
+            }
+        }
+
+        // Paires mises de côté : un test SAT groupé par boîte orientée
+        CollideOriented();
+    }
+
+    // Impulsions séquentielles, repartant de celles du pas précédent
+    {
+        WOBBLY_PROFILE_PHASE(m_profiler, PhysicsPhase::ContactSolve);
+        m_contacts.Prepare(m_bodies, deltaTime);
+        for (int iteration = 0; iteration < CONTACT_ITERATIONS; ++iteration) {
+            m_contacts.Solve(m_bodies);
+        }
+        m_contacts.Correct(m_bodies);
+
+        // Impulsions finales : début, suite ou fin de chaque contact
+        m_contactEvents.Record(m_bodies, m_contacts.GetContacts());
+    }
+
+    m_collisionStats.bodyCount = bodyCount;
+    m_collisionStats.persistentPairs = pairs.size();
+    m_collisionStats.pairsTested = pairsTested;
+    m_collisionStats.pairsCulled = allPairs - pairsTested;
+    m_collisionStats.staticBodies = m_staticGeometry.GetShapeCount();
+    m_collisionStats.staticContacts = staticContacts;
+    m_collisionStats.contacts = m_contacts.GetContacts().size();
+    m_collisionStats.warmStarted = m_contacts.GetWarmStartedCount();
+
+    // Les déplacements des cinématiques ont été pris en compte
+    for (uint32_t i = 0; i < m_awakeCount; ++i) {
+        m_bodies.flags[i] &= ~BodyFlag_Moved;
+    }
 }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
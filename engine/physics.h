@@ -1,39 +1,112 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <glm/glm.hpp>
+#include "body_store.h"
+#include "broadphase.h"
+#include "contact_events.h"
+#include "contacts.h"
+#include "heightfield.h"
+#include "integrator.h"
+#include "islands.h"
+#include "oriented_box.h"
+#include "profiler.h"
+#include "skeleton.h"
+#include "spatial_index.h"
+#include "static_geometry.h"
+#include "snapshot.h"
 
 namespace Engine {
 
-// Représente un corps rigide dans le monde physique
+class ThreadPool;
+
+// Description d'un corps rigide (création et lecture).
+// Le moteur stocke les corps en structure-of-arrays dans un BodyStore ;
+// on y accède ensuite par BodyHandle.
 struct RigidBody {
     glm::vec3 position{0.0f};
     glm::vec3 velocity{0.0f};
-    glm::vec3 acceleration{0.0f};
-    glm::vec3 force{0.0f};
-    
+
     float mass = 1.0f;
     float friction = 0.3f;
     float restitution = 0.4f; // Bounciness
-    
+
     bool useGravity = true;
     bool isKinematic = false; // Ne bouge pas avec la physique
-    
+    bool isStatic = false;    // Géométrie fixe du niveau (implique isKinematic)
+
+    // Les corps d'un même groupe (≠ 0, CreateCollisionGroup) ne se touchent
+    // pas : parties d'un ragdoll dont les boîtes se chevauchent par construction
+    uint32_t collisionGroup = 0;
+
     // AABB Collision box
     glm::vec3 boxMin{-0.5f};
     glm::vec3 boxMax{0.5f};
 };
 
+// Boîte orientée d'un corps cinématique (SetOrientation). shape.center est
+// relatif à la position du corps.
+struct OrientedBody {
+    BodyHandle body;
+    OrientedBox shape;
+    glm::vec3 angularVelocity{0.0f};
+};
+
 // Contrainte pour relier deux corps (articulations)
 struct Constraint {
-    RigidBody* bodyA;
-    RigidBody* bodyB;
-    float restLength;
-    float stiffness = 0.8f;
-    
-    Constraint(RigidBody* a, RigidBody* b, float length)
-        : bodyA(a), bodyB(b), restLength(length) {}
+    BodyHandle bodyA;
+    BodyHandle bodyB;
+    float restLength = 0.0f;
+    float stiffness = 0.8f;  // Solveur itératif : part de l'erreur corrigée par passe
+    float compliance = 0.0f; // Solveur XPBD : inverse de la raideur (m/N), 0 = rigide
+
+    Constraint() = default;
+    Constraint(BodyHandle a, BodyHandle b, float length, float jointCompliance = 0.0f)
+        : bodyA(a), bodyB(b), restLength(length), compliance(jointCompliance) {}
+};
+
+// Schéma de résolution des contraintes
+enum class SolverMode {
+    Iterative, // Forces, passes de correction de position, puis positions
+    Xpbd       // Sous-pas XPBD, une passe par sous-pas, raideur par compliance
+};
+
+// Compteurs du pas de temps (mis à jour à chaque Update)
+struct TimestepStats {
+    int substeps = 0;          // Pas simulés pendant le dernier Update
+    int droppedSteps = 0;      // Pas abandonnés parce que la simulation était en retard
+    float interpolationAlpha = 1.0f;
+};
+
+// Compteurs du solveur de contraintes (mis à jour à chaque Update)
+struct SolverStats {
+    int iterations = 0;          // Passes du dernier pas
+    int totalIterations = 0;     // Passes de tous les pas du dernier Update
+    int budgetStops = 0;         // Pas arrêtés par le budget de temps avant d'atteindre la tolérance
+    int iterationLimitStops = 0; // Pas arrêtés par le maximum de passes avant d'atteindre la tolérance
+    float residualError = 0.0f;  // Plus grand écart de longueur à la dernière passe (m)
+};
+
+// LOD physique : distances au point focal (m) au-delà desquelles un îlot
+// passe au demi, puis au quart de régime, puis se fige
+struct LodSettings {
+    bool enabled = false;
+    float halfRateDistance = 30.0f;
+    float quarterRateDistance = 60.0f;
+    float freezeDistance = 120.0f;
+    float hysteresis = 4.0f; // Marge autour de chaque distance (pas d'aller-retour)
+};
+
+// Corps des îlots éveillés par niveau (mis à jour à chaque évaluation du LOD)
+struct LodStats {
+    size_t fullRateBodies = 0;
+    size_t halfRateBodies = 0;
+    size_t quarterRateBodies = 0;
+    size_t frozenBodies = 0;
 };
 
 // Moteur de physique principal
@@ -41,40 +114,353 @@ class PhysicsEngine {
 public:
     PhysicsEngine();
     ~PhysicsEngine();
-    
+
     // Gestion des corps
-    RigidBody* CreateRigidBody();
-    void RemoveRigidBody(RigidBody* body);
-    
-    // Gestion des contraintes
-    void AddConstraint(RigidBody* a, RigidBody* b, float length);
+    BodyHandle CreateRigidBody(const RigidBody& desc = RigidBody());
+    void RemoveRigidBody(BodyHandle body);
+    bool IsValid(BodyHandle body) const { return m_bodies.IsAlive(body); }
+    // Nouveau groupe de collision (RigidBody::collisionGroup), jamais 0
+    uint32_t CreateCollisionGroup() { return ++m_lastCollisionGroup; }
+
+    // Accès aux corps
+    RigidBody GetBody(BodyHandle body) const;
+    glm::vec3 GetPosition(BodyHandle body) const;
+    glm::vec3 GetInterpolatedPosition(BodyHandle body) const; // Pour le rendu
+    glm::vec3 GetVelocity(BodyHandle body) const;
+    glm::vec3 GetBoxSize(BodyHandle body) const;
+    void SetPosition(BodyHandle body, const glm::vec3& position);
+    void SetVelocity(BodyHandle body, const glm::vec3& velocity);
+    void ClearForces(BodyHandle body);
+    const BodyStore& GetBodies() const { return m_bodies; }
+
+    // Rotation d'un corps cinématique ou statique (colonnes : ses axes). Au
+    // premier appel, sa boîte devient une boîte orientée qui tourne autour de
+    // la position du corps. La broadphase (ou le BVH, pour un statique : la
+    // boîte balayée par sa rotation autour de angularVelocity) ne fait qu'un
+    // premier tri ; les contacts passent par un test SAT groupé par boîte
+    // orientée et les requêtes par un test exact. angularVelocity (rad/s) donne
+    // aussi la vitesse de sa surface. Rien ne s'endort à portée d'une boîte
+    // orientée statique.
+    void SetOrientation(BodyHandle body, const glm::mat3& rotation,
+                        const glm::vec3& angularVelocity = glm::vec3(0.0f));
+    glm::mat3 GetOrientation(BodyHandle body) const; // Identité si jamais orienté
+
+    // Sommeil : un îlot (corps reliés par des contraintes) dont l'énergie
+    // cinétique par kg reste sous le seuil pendant sleepSteps pas s'endort.
+    // Il se réveille au contact d'un corps éveillé, sur ApplyForce/ApplyImpulse,
+    // SetPosition/SetVelocity ou WakeBody.
+    void SetSleepingEnabled(bool enabled);
+    bool IsSleepingEnabled() const { return m_sleepingEnabled; }
+    void SetSleepThreshold(float energyPerKg, int sleepSteps);
+    bool IsSleeping(BodyHandle body) const;
+    void WakeBody(BodyHandle body);
+    const IslandStats& GetIslandStats() const { return m_islands.GetStats(); }
+
+    // LOD physique : loin du point focal (la caméra), un îlot n'avance plus
+    // qu'un pas sur deux puis sur quatre, avec un pas de temps doublé ou
+    // quadruplé (contraintes comprises), puis se fige : un îlot gelé n'est
+    // plus simulé et reste immobile pour les corps qui le touchent. Les
+    // îlots d'un même régime sont répartis sur les pas. Évalué tous les
+    // LodInterval pas ; en se rapprochant, un îlot regagne un niveau par
+    // évaluation. Désactivé, la simulation est exactement celle sans LOD.
+    void SetLodSettings(const LodSettings& settings);
+    const LodSettings& GetLodSettings() const { return m_lod; }
+    void SetLodFocus(const glm::vec3& focus) { m_lodFocus = focus; }
+    const LodStats& GetLodStats() const { return m_lodStats; }
+
+    // Gestion des contraintes (compliance : utilisée par le solveur XPBD)
+    void AddConstraint(BodyHandle a, BodyHandle b, float length, float compliance = 0.0f);
+
+    // Squelette à topologie fixe (table constexpr SkeletonTopology) : parts
+    // contient Topology.PartCount corps. Ses joints sont résolus par un solveur
+    // instancié pour la topologie, sans coloration ni liste de contraintes ;
+    // les squelettes d'une même topologie sont résolus ensemble.
+    template <const auto& Topology>
+    void AddSkeleton(const BodyHandle* parts) {
+        AddSkeleton(&Topology, Topology.PartCount, Topology.joints, Topology.JointCount,
+                    &SolveSkeletons<Topology>, parts);
+    }
+    size_t GetSkeletonCount() const;
     
+    // Solveur parallèle : les contraintes sont colorées pour qu'aucun lot ne
+    // touche deux fois le même corps, puis chaque lot est réparti sur les threads.
+    // 1 = série (par défaut)
+    void SetWorkerThreads(size_t threadCount);
+    size_t GetWorkerThreads() const;
+    size_t GetConstraintColorCount() const { return m_colorOffsets.empty() ? 0 : m_colorOffsets.size() - 1; }
+
+    // Solveur adaptatif : les passes s'arrêtent dès que le plus grand écart de
+    // longueur descend sous la tolérance (après minIterations), ou quand le
+    // budget du pas est épuisé (maxIterations, ou le temps : 0 = sans limite,
+    // ignoré en mode déterministe pour que les résultats restent reproductibles)
+    void SetSolverTolerance(float meters) { m_solverTolerance = std::max(meters, 0.0f); }
+    void SetSolverIterations(int minIterations, int maxIterations);
+    void SetSolverTimeBudget(float microseconds) { m_solverTimeBudget = std::max(microseconds, 0.0f); }
+    const SolverStats& GetSolverStats() const { return m_solverStats; }
+
+    // XPBD : chaque pas est découpé en substeps sous-pas (forces, positions,
+    // une passe de contraintes, vitesses). Les articulations ne dépendent plus
+    // du nombre de passes ni du pas de temps ; tolérance et budget ne s'appliquent
+    // pas. Les collisions restent résolues une fois par pas.
+    void SetSolverMode(SolverMode mode) { m_solverMode = mode; }
+    SolverMode GetSolverMode() const { return m_solverMode; }
+    void SetXpbdSubsteps(int substeps) { m_xpbdSubsteps = std::max(1, substeps); }
+    int GetXpbdSubsteps() const { return m_xpbdSubsteps; }
+
+    // Géométrie statique : les corps isStatic sont regroupés dans un BVH,
+    // jamais intégrés ni testés entre eux. À reconstruire après avoir ajouté,
+    // retiré ou déplacé des corps statiques (sinon fait au prochain pas).
+    void RebuildStaticGeometry();
+    size_t GetStaticBodyCount() const { return m_staticBodies.size(); }
+
+    // Sol : grille de hauteurs, plate en y = 0 par défaut. La changer
+    // réveille tous les corps.
+    void SetTerrain(const Heightfield& terrain);
+    const Heightfield& GetTerrain() const { return m_terrain; }
+
     // Configuration
     void SetGravity(const glm::vec3& gravity) { m_gravity = gravity; }
     glm::vec3 GetGravity() const { return m_gravity; }
     
+    // Noyaux d'intégration (détecté au démarrage, limité au niveau supporté)
+    void SetSimdLevel(SimdLevel level);
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+
+    // Pas fixe : 0 = un pas par Update (deltaTime limité à 20 ms)
+    void SetFixedTimestep(float hz);
+    float GetFixedTimestep() const { return m_fixedDelta; }
+    void SetMaxSubsteps(int maxSubsteps) { m_maxSubsteps = std::max(1, maxSubsteps); }
+    float GetInterpolationAlpha() const { return m_timestepStats.interpolationAlpha; }
+    const TimestepStats& GetTimestepStats() const { return m_timestepStats; }
+    
     // Mise à jour
     void Update(float deltaTime);
-    
+
+    // Instantané de tout l'état simulé (corps, contraintes, gravité, pas fixe,
+    // caches de collision et de sommeil), fait de copies brutes de tableaux.
+    // Restaurer puis simuler redonne exactement les mêmes résultats (même binaire).
+    // Les réglages (threads, SIMD, mode déterministe) ne sont pas concernés.
+    // Un LoadState qui échoue laisse le moteur dans un état invalide.
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+    void SaveState(SnapshotBlob& blob) const;
+    bool LoadState(const SnapshotBlob& blob);
+
+    // Mode déterministe : Update s'exécute avec l'environnement flottant par
+    // défaut sur tous les threads, quel que soit celui de l'application
+    void SetDeterministic(bool enabled) { m_deterministic = enabled; }
+    bool IsDeterministic() const { return m_deterministic; }
+
     // Appliquer des forces
-    void ApplyForce(RigidBody* body, const glm::vec3& force);
-    void ApplyImpulse(RigidBody* body, const glm::vec3& impulse);
-    
-    // Détection de collision
-    bool CheckCollision(const RigidBody& a, const RigidBody& b);
-    void ResolveCollision(RigidBody& a, RigidBody& b);
-    
+    void ApplyForce(BodyHandle body, const glm::vec3& force);
+    void ApplyImpulse(BodyHandle body, const glm::vec3& impulse);
+
+    // Détection de collision. Les corps reliés par une contrainte ne
+    // collisionnent pas entre eux (leurs boîtes se chevauchent au repos).
+    bool CheckCollision(BodyHandle a, BodyHandle b) const;
+    void ResolveCollision(BodyHandle a, BodyHandle b); // Impulsion isolée, sans cache
+
+    // Statistiques de la dernière passe de collision
+    const CollisionStats& GetCollisionStats() const { return m_collisionStats; }
+
+    // Contacts commencés, maintenus et terminés pendant le dernier Update, dans
+    // l'ordre des pas (vide si aucun pas n'a été simulé). À lire après Update :
+    // le tampon est réutilisé au suivant.
+    const std::vector<ContactEvent>& GetContactEvents() const { return m_contactEvents.GetEvents(); }
+
+    // Temps par phase et compteurs des derniers Update (vide si le moteur
+    // est compilé sans WOBBLY_PROFILING)
+    PhysicsProfiler& GetProfiler() { return m_profiler; }
+    const PhysicsProfiler& GetProfiler() const { return m_profiler; }
+
+    // Requêtes spatiales, sans allocation. La statique passe par le BVH, les
+    // autres corps par un index trié sur Z remis à jour à la demande (au plus
+    // une fois entre deux pas). Plusieurs threads peuvent interroger le moteur
+    // en même temps, mais pas pendant un Update ou une modification des corps.
+
+    // Premier corps touché par le rayon (direction normalisée ici) ; le sol
+    // rend un hit dont body est invalide
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RaycastHit& hit,
+                 const QueryFilter& filter = QueryFilter()) const;
+
+    // fn(handle) pour chaque corps dont l'AABB touche [boxMin, boxMax]
+    template <typename Fn>
+    void OverlapAABB(const glm::vec3& boxMin, const glm::vec3& boxMax, const QueryFilter& filter, Fn&& fn) const {
+        auto visit = [&](BodyHandle body) {
+            if (!filter.Ignores(body)) fn(body);
+        };
+        if (filter.staticBodies) QueryStatic(boxMin, boxMax, visit);
+        if (filter.dynamicBodies) {
+            RefreshQueryIndex();
+            m_queryIndex.Query(boxMin, boxMax, visit);
+        }
+    }
+    // Remplit results (capacity au plus) ; retourne le nombre total de corps
+    // trouvés, qui peut dépasser capacity
+    size_t OverlapAABB(const glm::vec3& boxMin, const glm::vec3& boxMax, BodyHandle* results, size_t capacity,
+                       const QueryFilter& filter = QueryFilter()) const;
+
+    // Boîte [boxMin, boxMax] déplacée de delta : premier contact. fraction = 0
+    // si elle touche déjà quelque chose au départ.
+    bool SweepAABB(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& delta, SweepHit& hit,
+                   const QueryFilter& filter = QueryFilter()) const;
+
 private:
-    void IntegrateForces(RigidBody& body, float deltaTime);
-    void IntegrateVelocity(RigidBody& body, float deltaTime);
-    void SolveConstraints();
-    void HandleCollisions();
-    
-    std::vector<std::unique_ptr<RigidBody>> m_bodies;
+    // Créneaux LOD des corps éveillés, rangés dans cet ordre : 0 plein
+    // régime, 1-2 demi-régime (pas pairs, impairs), 3-6 quart de régime
+    static constexpr uint32_t LodSlots = 7;
+    static constexpr uint32_t LodInterval = 4; // Multiple des deux périodes
+    struct LodPass {
+        uint32_t slot;
+        float scale; // Multiple du pas de temps
+    };
+    using LodPasses = LodPass[3];
+
+    void Step(float deltaTime);
+    size_t GetLodPasses(LodPasses& passes) const; // Créneaux qui avancent pendant ce pas
+    void UpdateLod();
+    void SetIdleSlots(const LodPasses& passes, size_t passCount, bool idle);
+    void IntegrateForces(float deltaTime, uint32_t slot);
+    void IntegrateVelocity(float deltaTime, uint32_t slot);
+    void SolveConstraintPasses(uint32_t slot);
+    void StepXpbd(float deltaTime, uint32_t slot);
+    float SolveConstraints(uint32_t slot);
+    float SolveConstraintRange(size_t begin, size_t end);
+    float SolveXpbdRange(size_t begin, size_t end);
+    void AddSkeleton(const void* topology, size_t partCount, const SkeletonJoint* joints, size_t jointCount,
+                     SkeletonSolveFn solve, const BodyHandle* parts);
+    float SolveSkeletonGroups(uint32_t slot);
+    bool HasAwakeJoints(uint32_t slot) const { return m_awakeJoints[slot] > 0; }
+    void ColorConstraints();
+    void RebuildJointFilter();
+    void HandleCollisions(float deltaTime, const LodPasses& passes, size_t passCount);
+    void PurgeDeadConstraints();
+    void RebuildIslands();
+    void PartitionAwakeBodies();
+    void GatherAwakeConstraints();
+    void WakeDense(uint32_t i);
+    void WakeTouching(uint32_t i);
+    void WakeNearOriented();
+    bool CheckCollisionDense(uint32_t a, uint32_t b) const;
+    void RemoveOriented(BodyHandle body);
+    OrientedBox WorldBox(const OrientedBody& oriented) const;
+    Contact OrientedContact(const OrientedBody& oriented, const OrientedBox& box, const SatAxes& axes,
+                            uint32_t other, float depth, int axis) const;
+    bool MeasureOriented(uint32_t a, uint32_t b, float margin, Contact& contact) const;
+    void DeferOriented(uint32_t a, uint32_t b, uint32_t sleeper);
+    void CollideOriented();
+    void RefreshQueryIndex() const;
+    void MarkQueryIndexDirty(bool rebuild);
+    bool CastClosest(const glm::vec3& origin, const glm::vec3& delta, const glm::vec3& expand, float maxT,
+                     const QueryFilter& filter, BodyHandle& body, float& t, glm::vec3& normal) const;
+    bool CastOriented(uint32_t i, const glm::vec3& origin, const glm::vec3& delta, const glm::vec3& expand,
+                      float maxT, float& t, glm::vec3& normal) const;
+
+    // BVH, ou parcours direct des corps statiques s'il n'est pas encore reconstruit
+    template <typename Fn>
+    void QueryStatic(const glm::vec3& boxMin, const glm::vec3& boxMax, Fn&& fn) const {
+        if (!m_staticDirty) {
+            m_staticGeometry.Query(boxMin, boxMax, fn);
+            return;
+        }
+        for (BodyHandle body : m_staticBodies) {
+            uint32_t i = m_bodies.DenseIndex(body);
+            glm::vec3 shapeMin = m_bodies.Position(i) + m_bodies.BoxMin(i);
+            glm::vec3 shapeMax = m_bodies.Position(i) + m_bodies.BoxMax(i);
+            if (shapeMin.x <= boxMax.x && shapeMax.x >= boxMin.x &&
+                shapeMin.y <= boxMax.y && shapeMax.y >= boxMin.y &&
+                shapeMin.z <= boxMax.z && shapeMax.z >= boxMin.z) {
+                fn(body);
+            }
+        }
+    }
+
+    BodyStore m_bodies;
     std::vector<Constraint> m_constraints;
+    bool m_hasDeadConstraints = false;
+    
+    // Lots de couleurs : m_constraints[m_colorOffsets[c], m_colorOffsets[c + 1])
+    std::vector<size_t> m_colorOffsets;
+    size_t m_serialBatch = 0;          // Premier lot à résoudre en série (débordement)
+    bool m_constraintsDirty = false;
+    // Contraintes des îlots éveillés, par lot puis par créneau LOD :
+    // m_awakeConstraints[m_awakeOffsets[k], m_awakeOffsets[k + 1]), k = c * LodSlots + créneau
+    std::vector<uint32_t> m_awakeConstraints;
+    std::vector<size_t> m_awakeOffsets;
+    std::vector<uint32_t> m_constraintDense; // Indices denses (A, B) de chaque contrainte éveillée
+    std::vector<SkeletonGroup> m_skeletons;  // Un groupe par topologie
+    size_t m_awakeJoints[LodSlots] = {};     // Contraintes et squelettes éveillés par créneau
+    std::unique_ptr<ThreadPool> m_threadPool;
+    SweepAndPrune m_broadphase;
+    StaticGeometry m_staticGeometry;
+    std::vector<BodyHandle> m_staticBodies;
+    bool m_staticDirty = false;
+    // Index des requêtes spatiales (hors instantanés : reconstruit au besoin)
+    mutable SpatialIndex m_queryIndex;
+    mutable std::mutex m_queryMutex;
+    mutable std::atomic<bool> m_queryDirty{true};
+    mutable bool m_queryRebuild = true; // Corps ajoutés ou retirés depuis
+    CollisionStats m_collisionStats;
+    Heightfield m_terrain;
+    std::vector<float> m_groundSpeed; // Sortie de CollideTerrainBatch
+    ContactSolver m_contacts;
+    // Boîtes orientées (m_orientedIndex : handle.index -> indice) et, pendant
+    // la narrowphase, les corps à tester contre chacune
+    struct OrientedCandidate {
+        uint32_t other;   // Indice dense
+        uint32_t sleeper; // Corps endormi à réveiller au contact, ou NoSleeper
+    };
+    static constexpr uint32_t NoSleeper = 0xFFFFFFFFu;
+    std::vector<OrientedBody> m_oriented;
+    PairIndex m_orientedIndex;
+    std::vector<std::vector<OrientedCandidate>> m_orientedCandidates;
+    std::vector<uint32_t> m_orientedPending; // Boîtes qui ont des candidats, dans l'ordre
+    SatAxes m_satAxes;
+    AabbBatch m_satBatch;
+    std::vector<float> m_satDepth;
+    std::vector<uint8_t> m_satAxis;
+    ContactEvents m_contactEvents;
+    PairIndex m_jointedPairs; // Paires de corps reliés par une contrainte
+    uint32_t m_lastCollisionGroup = 0;
     glm::vec3 m_gravity{0.0f, -9.81f, 0.0f};
+    SimdLevel m_simdLevel = SimdLevel::Scalar;
+    bool m_deterministic = false;
+
+    // Les corps éveillés occupent les m_awakeCount premiers indices denses,
+    // suivis des corps endormis, gelés et statiques
+    IslandManager m_islands;
+    bool m_sleepingEnabled = true;
+    float m_sleepEnergy = 0.01f; // J/kg (~0.14 m/s)
+    int m_sleepSteps = 60;
+    uint32_t m_awakeCount = 0;
+    bool m_layoutDirty = true; // Partition et contraintes éveillées à refaire
+
+    // LOD : les corps du créneau s occupent [m_lodOffsets[s], m_lodOffsets[s + 1])
+    LodSettings m_lod;
+    LodStats m_lodStats;
+    glm::vec3 m_lodFocus{0.0f};
+    uint32_t m_lodStep = 0;
+    uint32_t m_lodOffsets[LodSlots + 1] = {};
     
-    const int CONSTRAINT_ITERATIONS = 5; // Plus = plus stable
+    // Pas fixe
+    float m_fixedDelta = 0.0f;
+    float m_accumulator = 0.0f;
+    int m_maxSubsteps = 8;
+    TimestepStats m_timestepStats;
+
+    // Solveur de contraintes
+    float m_solverTolerance = 0.001f; // 1 mm
+    int m_minIterations = 1;
+    int m_maxIterations = 10;
+    float m_solverTimeBudget = 0.0f;  // µs par pas
+    SolverStats m_solverStats;
+    PhysicsProfiler m_profiler;
+    SolverMode m_solverMode = SolverMode::Iterative;
+    int m_xpbdSubsteps = 8;
+    float m_substepDelta = 0.0f;
+    std::vector<float> m_substepX, m_substepY, m_substepZ; // Positions avant la passe de contraintes
+
+    const int CONTACT_ITERATIONS = 2;    // Suffisant grâce au warm start
 };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
@@ -0,0 +1,147 @@
+#include "profiler.h"
+#include <algorithm>
+#include <fstream>
+
+namespace Engine {
+
+const char* PhysicsProfiler::PhaseName(PhysicsPhase phase) {
+    switch (phase) {
+        case PhysicsPhase::Prepare: return "prepare";
+        case PhysicsPhase::IntegrateForces: return "integrate_forces";
+        case PhysicsPhase::Constraints: return "constraints";
+        case PhysicsPhase::IntegrateVelocity: return "integrate_velocity";
+        case PhysicsPhase::Ground: return "ground";
+        case PhysicsPhase::Broadphase: return "broadphase";
+        case PhysicsPhase::Narrowphase: return "narrowphase";
+        case PhysicsPhase::ContactSolve: return "contact_solve";
+        case PhysicsPhase::Sleep: return "sleep";
+        case PhysicsPhase::Count: break;
+    }
+    return "unknown";
+}
+
+void PhysicsProfiler::SetCapacity(size_t frames) {
+    m_capacity = std::max<size_t>(frames, 1);
+    m_frames.clear();
+    m_frames.shrink_to_fit();
+    Clear();
+}
+
+void PhysicsProfiler::Clear() {
+    m_next = 0;
+    m_count = 0;
+}
+
+void PhysicsProfiler::BeginFrame() {
+    m_current = PhysicsProfileFrame();
+    m_frameStart = Clock::now();
+}
+
+void PhysicsProfiler::EndFrame(const PhysicsProfileFrame& counters) {
+    std::chrono::duration<float, std::micro> elapsed = Clock::now() - m_frameStart;
+
+    PhysicsProfileFrame frame = counters;
+    frame.frame = m_frameNumber++;
+    frame.updateMicros = elapsed.count();
+    std::copy_n(m_current.phaseMicros, PHYSICS_PHASE_COUNT, frame.phaseMicros);
+
+    if (m_frames.size() != m_capacity) {
+        m_frames.resize(m_capacity);
+    }
+    m_frames[m_next] = frame;
+    m_next = (m_next + 1) % m_capacity;
+    m_count = std::min(m_count + 1, m_capacity);
+}
+
+const PhysicsProfileFrame& PhysicsProfiler::GetFrame(size_t age) const {
+    return m_frames[(m_next + m_capacity - 1 - age) % m_capacity];
+}
+
+PhysicsProfileFrame PhysicsProfiler::GetAverage() const {
+    PhysicsProfileFrame average;
+    if (m_count == 0) return average;
+
+    // Sommes en double : des milliers de frames de quelques µs
+    double update = 0.0;
+    double phases[PHYSICS_PHASE_COUNT] = {};
+    uint64_t steps = 0, bodies = 0, awake = 0, pairs = 0, tested = 0, contacts = 0, iterations = 0;
+    for (size_t age = 0; age < m_count; ++age) {
+        const PhysicsProfileFrame& frame = GetFrame(age);
+        update += frame.updateMicros;
+        for (size_t p = 0; p < PHYSICS_PHASE_COUNT; ++p) {
+            phases[p] += frame.phaseMicros[p];
+        }
+        steps += frame.steps;
+        bodies += frame.bodies;
+        awake += frame.awakeBodies;
+        pairs += frame.activePairs;
+        tested += frame.pairsTested;
+        contacts += frame.contacts;
+        iterations += frame.iterations;
+    }
+
+    const double n = static_cast<double>(m_count);
+    average.frame = m_count;
+    average.updateMicros = static_cast<float>(update / n);
+    for (size_t p = 0; p < PHYSICS_PHASE_COUNT; ++p) {
+        average.phaseMicros[p] = static_cast<float>(phases[p] / n);
+    }
+    average.steps = static_cast<uint32_t>(steps / m_count);
+    average.bodies = static_cast<uint32_t>(bodies / m_count);
+    average.awakeBodies = static_cast<uint32_t>(awake / m_count);
+    average.activePairs = static_cast<uint32_t>(pairs / m_count);
+    average.pairsTested = static_cast<uint32_t>(tested / m_count);
+    average.contacts = static_cast<uint32_t>(contacts / m_count);
+    average.iterations = static_cast<uint32_t>(iterations / m_count);
+    return average;
+}
+
+bool PhysicsProfiler::WriteCsv(const char* path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "frame,steps,update_us";
+    for (size_t p = 0; p < PHYSICS_PHASE_COUNT; ++p) {
+        file << ',' << PhaseName(static_cast<PhysicsPhase>(p)) << "_us";
+    }
+    file << ",bodies,awake_bodies,active_pairs,pairs_tested,contacts,iterations\n";
+
+    for (size_t age = m_count; age-- > 0;) {
+        const PhysicsProfileFrame& frame = GetFrame(age);
+        file << frame.frame << ',' << frame.steps << ',' << frame.updateMicros;
+        for (float micros : frame.phaseMicros) {
+            file << ',' << micros;
+        }
+        file << ',' << frame.bodies << ',' << frame.awakeBodies << ',' << frame.activePairs << ','
+             << frame.pairsTested << ',' << frame.contacts << ',' << frame.iterations << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool PhysicsProfiler::WriteJson(const char* path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "{\n  \"phases\": [";
+    for (size_t p = 0; p < PHYSICS_PHASE_COUNT; ++p) {
+        file << (p ? ", " : "") << '"' << PhaseName(static_cast<PhysicsPhase>(p)) << '"';
+    }
+    file << "],\n  \"frames\": [";
+
+    for (size_t age = m_count; age-- > 0;) {
+        const PhysicsProfileFrame& frame = GetFrame(age);
+        file << (age + 1 < m_count ? ",\n" : "\n") << "    {\"frame\": " << frame.frame
+             << ", \"steps\": " << frame.steps << ", \"update_us\": " << frame.updateMicros
+             << ", \"phase_us\": [";
+        for (size_t p = 0; p < PHYSICS_PHASE_COUNT; ++p) {
+            file << (p ? ", " : "") << frame.phaseMicros[p];
+        }
+        file << "], \"bodies\": " << frame.bodies << ", \"awake_bodies\": " << frame.awakeBodies
+             << ", \"active_pairs\": " << frame.activePairs << ", \"pairs_tested\": " << frame.pairsTested
+             << ", \"contacts\": " << frame.contacts << ", \"iterations\": " << frame.iterations << '}';
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+} // namespace Engine
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Instrumentation par phase de PhysicsEngine::Update. Définie par CMake
+// (option WOBBLY_PROFILING) : sans elle, les chronos et l'enregistrement
+// disparaissent à la compilation et le profileur reste vide.
+#if defined(WOBBLY_PROFILING)
+    #define WOBBLY_PROFILE_CONCAT_(a, b) a##b
+    #define WOBBLY_PROFILE_CONCAT(a, b) WOBBLY_PROFILE_CONCAT_(a, b)
+    #define WOBBLY_PROFILE_PHASE(profiler, phase) \
+        ::Engine::ScopedPhaseTimer WOBBLY_PROFILE_CONCAT(phaseTimer, __LINE__)(profiler, phase)
+#else
+    #define WOBBLY_PROFILE_PHASE(profiler, phase) ((void)0)
+#endif
+
+namespace Engine {
+
+// Phases d'un pas, dans l'ordre d'exécution
+enum class PhysicsPhase : uint8_t {
+    Prepare,           // Contraintes mortes, coloration, îlots, BVH statique, partition
+    IntegrateForces,
+    Constraints,       // Passes itératives ou XPBD
+    IntegrateVelocity,
+    Ground,            // Sol (Heightfield)
+    Broadphase,        // Sweep-and-prune
+    Narrowphase,       // Paires candidates et géométrie statique
+    ContactSolve,      // Warm start, impulsions, correction
+    Sleep,
+    Count
+};
+
+constexpr size_t PHYSICS_PHASE_COUNT = static_cast<size_t>(PhysicsPhase::Count);
+
+// Un Update : temps cumulés sur tous ses pas (µs) et compteurs du dernier pas
+struct PhysicsProfileFrame {
+    uint64_t frame = 0;      // Numéro de l'Update depuis la création du moteur
+    uint32_t steps = 0;
+    float updateMicros = 0.0f;
+    float phaseMicros[PHYSICS_PHASE_COUNT] = {};
+
+    uint32_t bodies = 0;
+    uint32_t awakeBodies = 0;
+    uint32_t activePairs = 0; // Paires qui se chevauchent sur Z
+    uint32_t pairsTested = 0;
+    uint32_t contacts = 0;
+    uint32_t iterations = 0;  // Passes de contraintes, tous pas confondus
+};
+
+// Tampon circulaire des derniers Update. Rien n'est alloué avant le premier
+// enregistrement ; écrit par le thread qui appelle Update.
+class PhysicsProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const char* PhaseName(PhysicsPhase phase);
+
+    // Nombre d'Update gardés (vide le tampon)
+    void SetCapacity(size_t frames);
+    size_t GetCapacity() const { return m_capacity; }
+    void Clear();
+
+    // Update en cours : les phases s'ajoutent à la frame ouverte
+    void BeginFrame();
+    void AddPhase(PhysicsPhase phase, float micros) {
+        m_current.phaseMicros[static_cast<size_t>(phase)] += micros;
+    }
+    void EndFrame(const PhysicsProfileFrame& counters);
+
+    // age 0 = Update le plus récent
+    size_t GetFrameCount() const { return m_count; }
+    const PhysicsProfileFrame& GetFrame(size_t age) const;
+    // Moyenne des frames gardées (frame = nombre de frames moyennées)
+    PhysicsProfileFrame GetAverage() const;
+
+    // De la plus ancienne à la plus récente. Faux si le fichier n'a pas pu être écrit.
+    bool WriteCsv(const char* path) const;
+    bool WriteJson(const char* path) const;
+
+private:
+    std::vector<PhysicsProfileFrame> m_frames;
+    size_t m_capacity = 600; // 5 s à 120 Hz
+    size_t m_next = 0;
+    size_t m_count = 0;
+    uint64_t m_frameNumber = 0;
+    PhysicsProfileFrame m_current;
+    Clock::time_point m_frameStart;
+};
+
+// Chrono d'une phase, ajouté à la frame ouverte en sortie de portée
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(PhysicsProfiler& profiler, PhysicsPhase phase)
+        : m_profiler(profiler), m_phase(phase), m_start(PhysicsProfiler::Clock::now()) {}
+    ~ScopedPhaseTimer() {
+        std::chrono::duration<float, std::micro> elapsed = PhysicsProfiler::Clock::now() - m_start;
+        m_profiler.AddPhase(m_phase, elapsed.count());
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    PhysicsProfiler& m_profiler;
+    PhysicsPhase m_phase;
+    PhysicsProfiler::Clock::time_point m_start;
+};
+
+} // namespace Engine
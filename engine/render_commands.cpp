@@ -0,0 +1,100 @@
+#include "render_commands.h"
+#include <cstring>
+#include <utility>
+
+namespace Engine {
+
+namespace {
+
+const glm::vec3 AXIS_X(1.0f, 0.0f, 0.0f);
+const glm::vec3 AXIS_Y(0.0f, 1.0f, 0.0f);
+const glm::vec3 AXIS_Z(0.0f, 0.0f, 1.0f);
+
+// Profondeur triable : les bits d'un flottant positif croissent avec lui, on
+// garde les 24 de poids fort (8 bits de mantisse perdus, sans effet visible)
+uint32_t DepthKey(const glm::vec3& point, const glm::vec3& eye) {
+    glm::vec3 d = point - eye;
+    float distanceSq = glm::dot(d, d);
+    uint32_t bits;
+    std::memcpy(&bits, &distanceSq, sizeof(bits));
+    return bits >> 8;
+}
+
+} // namespace
+
+void RenderCommandList::DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec3& color) {
+    m_commands.push_back({RenderPrimitive::Cube, color, position, size, AXIS_X, AXIS_Y, AXIS_Z});
+}
+
+void RenderCommandList::DrawBox(const glm::vec3& position, const glm::vec3& size, const glm::mat3& rotation,
+                                const glm::vec3& color) {
+    m_commands.push_back({RenderPrimitive::Cube, color, position, size, rotation[0], rotation[1], rotation[2]});
+}
+
+void RenderCommandList::DrawSphere(const glm::vec3& position, float radius, const glm::vec3& color) {
+    // Simplification: une sphère est dessinée comme un cube de même encombrement
+    DrawCube(position, glm::vec3(radius * 2.0f), color);
+}
+
+void RenderCommandList::DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color) {
+    m_commands.push_back({RenderPrimitive::Line, color, start, end, AXIS_X, AXIS_Y, AXIS_Z});
+}
+
+void RenderCommandList::Append(const RenderCommandList& other) {
+    m_commands.insert(m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+}
+
+void RenderCommandList::Clear() {
+    m_commands.clear();
+    m_keys.clear();
+}
+
+void RenderCommandList::Reserve(size_t count) {
+    m_commands.reserve(count);
+    m_keys.reserve(count);
+    m_scratch.reserve(count);
+}
+
+void RenderCommandList::Sort(const glm::vec3& eye) {
+    const size_t count = m_commands.size();
+    m_keys.resize(count);
+    m_scratch.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const RenderCommand& command = m_commands[i];
+        // Une ligne est rangée par son milieu
+        glm::vec3 anchor = command.primitive == RenderPrimitive::Line ? (command.a + command.b) * 0.5f : command.a;
+        uint64_t high = (static_cast<uint64_t>(command.primitive) << 24) | DepthKey(anchor, eye);
+        m_keys[i] = (high << 32) | static_cast<uint32_t>(i);
+    }
+
+    // Tri radix LSD, un octet par passe sur les 32 bits de poids fort ; l'indice
+    // d'origine (bits de poids faible) n'est pas trié mais départage les égalités
+    // dans l'ordre d'ajout, le tri étant stable
+    uint64_t* src = m_keys.data();
+    uint64_t* dst = m_scratch.data();
+    for (int shift = 32; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            histogram[(src[i] >> shift) & 0xff]++;
+        }
+        // Octet identique partout (fréquent pour la primitive) : passe inutile
+        if (count == 0 || histogram[(src[0] >> shift) & 0xff] == count) continue;
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[histogram[(src[i] >> shift) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    if (src != m_keys.data()) {
+        m_keys.swap(m_scratch);
+    }
+}
+
+} // namespace Engine
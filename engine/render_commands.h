@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Engine {
+
+// Primitive d'une commande : chacune a son pipeline (programme instancié pour
+// les cubes, lignes fixes), soumis d'un bloc après le tri
+enum class RenderPrimitive : uint8_t {
+    Cube, // Cubes, pavés et sphères : cube unité instancié
+    Line
+};
+
+// Commande de dessin, copiable octet par octet (fusion entre threads)
+struct RenderCommand {
+    RenderPrimitive primitive;
+    glm::vec3 color;
+    glm::vec3 a; // Cube : centre ; ligne : début
+    glm::vec3 b; // Cube : dimensions ; ligne : fin
+    glm::vec3 axisX, axisY, axisZ; // Cube : colonnes de rotation
+};
+static_assert(std::is_trivially_copyable<RenderCommand>::value, "RenderCommand doit rester POD");
+
+// Liste de commandes d'une frame, sans appel GL : elle peut être remplie sur
+// n'importe quel thread (une liste par thread), fusionnée par Append puis triée
+// et soumise par le Renderer à EndFrame
+class RenderCommandList {
+public:
+    void DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec3& color);
+    void DrawBox(const glm::vec3& position, const glm::vec3& size, const glm::mat3& rotation, const glm::vec3& color);
+    void DrawSphere(const glm::vec3& position, float radius, const glm::vec3& color);
+    void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color);
+
+    // Ajoute les commandes d'une autre liste (l'ordre final vient du tri)
+    void Append(const RenderCommandList& other);
+    void Clear();
+    void Reserve(size_t count);
+
+    // Tri par clé 64 bits [primitive:8][profondeur:24][indice:32], tri radix sur
+    // les 32 bits de poids fort : primitives groupées, de l'avant vers l'arrière
+    // depuis eye à l'intérieur de chacune
+    void Sort(const glm::vec3& eye);
+
+    size_t GetCount() const { return m_commands.size(); }
+    // k-ième commande dans l'ordre du dernier Sort
+    const RenderCommand& GetSorted(size_t k) const {
+        return m_commands[static_cast<uint32_t>(m_keys[k])];
+    }
+
+private:
+    std::vector<RenderCommand> m_commands;
+    std::vector<uint64_t> m_keys;
+    std::vector<uint64_t> m_scratch; // Tampon de ping-pong du tri radix
+};
+
+} // namespace Engine
@@ -1,10 +1,119 @@
 #include "renderer.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#if defined(WOBBLY_HAS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
 
 namespace Engine {
 
+namespace {
+
+// Cube unité centré (12 triangles), chargé une seule fois dans m_cubeVbo
+const GLfloat UNIT_CUBE[] = {
+    // Face avant
+    -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+    // Face arrière
+    -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,   0.5f,  0.5f, -0.5f,
+    -0.5f, -0.5f, -0.5f,   0.5f,  0.5f, -0.5f,   0.5f, -0.5f, -0.5f,
+    // Face gauche
+    -0.5f, -0.5f, -0.5f,  -0.5f, -0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+    -0.5f, -0.5f, -0.5f,  -0.5f,  0.5f,  0.5f,  -0.5f,  0.5f, -0.5f,
+    // Face droite
+     0.5f, -0.5f, -0.5f,   0.5f,  0.5f, -0.5f,   0.5f,  0.5f,  0.5f,
+     0.5f, -0.5f, -0.5f,   0.5f,  0.5f,  0.5f,   0.5f, -0.5f,  0.5f,
+    // Face dessus
+    -0.5f,  0.5f, -0.5f,  -0.5f,  0.5f,  0.5f,   0.5f,  0.5f,  0.5f,
+    -0.5f,  0.5f, -0.5f,   0.5f,  0.5f,  0.5f,   0.5f,  0.5f, -0.5f,
+    // Face dessous
+    -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,
+    -0.5f, -0.5f, -0.5f,   0.5f, -0.5f,  0.5f,  -0.5f, -0.5f,  0.5f,
+};
+const GLsizei UNIT_CUBE_VERTICES = sizeof(UNIT_CUBE) / (3 * sizeof(GLfloat));
+
+const char* CUBE_VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 a_vertex;
+layout(location = 1) in vec3 a_position;
+layout(location = 2) in vec3 a_size;
+layout(location = 3) in vec3 a_color;
+layout(location = 4) in vec3 a_axisX;
+layout(location = 5) in vec3 a_axisY;
+layout(location = 6) in vec3 a_axisZ;
+
+uniform mat4 u_viewProjection;
+
+out vec3 v_color;
+
+void main() {
+    vec3 local = a_vertex * a_size;
+    vec3 world = a_position + a_axisX * local.x + a_axisY * local.y + a_axisZ * local.z;
+    v_color = a_color;
+    gl_Position = u_viewProjection * vec4(world, 1.0);
+}
+)";
+
+const char* CUBE_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec3 v_color;
+out vec4 o_color;
+
+void main() {
+    o_color = vec4(v_color, 1.0);
+}
+)";
+
+GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Erreur shader: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// GLEW compilé pour GLX signale l'absence de display X sous un contexte EGL ;
+// les fonctions GL sont pourtant chargées
+bool GlewReady(GLenum err) {
+#if defined(GLEW_ERROR_NO_GLX_DISPLAY)
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) return true;
+#endif
+    return err == GLEW_OK;
+}
+
+#if defined(WOBBLY_HAS_EGL)
+// Sans serveur X ni Wayland, l'affichage par défaut n'existe pas : prendre la
+// plateforme « surfaceless » de Mesa quand elle est là, sinon l'affichage par défaut
+EGLDisplay GetOffscreenDisplay() {
+#if defined(EGL_PLATFORM_SURFACELESS_MESA)
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+    }
+#endif
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+    return EGL_NO_DISPLAY;
+}
+#endif
+
+} // namespace
+
 Renderer::Renderer() {}
 
 Renderer::~Renderer() {
@@ -52,11 +161,109 @@ bool Renderer::Initialize(int width, int height, const std::string& title) {
     }
     
     SetupOpenGL();
+    if (!CreateShaders()) {
+        return false;
+    }
     
     std::cout << "✅ Renderer initialisé (OpenGL " << glGetString(GL_VERSION) << ")" << std::endl;
     return true;
 }
 
+bool Renderer::InitializeOffscreen(int width, int height, int framesPerSecond) {
+#if defined(WOBBLY_HAS_EGL)
+    m_width = width;
+    m_height = height;
+    m_aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    m_framesPerSecond = framesPerSecond;
+    m_frameIndex = 0;
+
+    EGLDisplay display = GetOffscreenDisplay();
+    if (display == EGL_NO_DISPLAY) {
+        std::cerr << "Erreur: Impossible d'initialiser EGL" << std::endl;
+        return false;
+    }
+    m_eglDisplay = display;
+    m_offscreen = true; // Shutdown libère ce qui a été créé, même en cas d'échec
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        std::cerr << "Erreur: Aucune configuration EGL pbuffer OpenGL" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    // Surface minimale : l'image va dans le FBO, à la taille demandée
+    const EGLint surfaceAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+    eglBindAPI(EGL_OPENGL_API);
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    m_eglSurface = surface == EGL_NO_SURFACE ? nullptr : surface;
+    m_eglContext = context == EGL_NO_CONTEXT ? nullptr : context;
+    if (!m_eglSurface || !m_eglContext || !eglMakeCurrent(display, surface, surface, context)) {
+        std::cerr << "Erreur: Impossible de créer le contexte EGL" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    glewExperimental = GL_TRUE;
+    GLenum err = glewInit();
+    if (!GlewReady(err)) {
+        std::cerr << "Erreur GLEW: " << glewGetErrorString(err) << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    // Framebuffer hors écran : couleur RGBA8 et profondeur à la taille demandée
+    glGenFramebuffers(1, &m_offscreenFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_offscreenFbo);
+    glGenRenderbuffers(1, &m_offscreenColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_offscreenColor);
+    glGenRenderbuffers(1, &m_offscreenDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_offscreenDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Erreur: Framebuffer hors écran incomplet" << std::endl;
+        Shutdown();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+
+    SetupOpenGL();
+    if (!CreateShaders()) {
+        Shutdown();
+        return false;
+    }
+
+    std::cout << "✅ Renderer hors écran initialisé (" << width << "x" << height << ", OpenGL "
+              << glGetString(GL_VERSION) << ", " << glGetString(GL_RENDERER) << ")" << std::endl;
+    return true;
+#else
+    (void)width;
+    (void)height;
+    (void)framesPerSecond;
+    std::cerr << "Erreur: Rendu hors écran indisponible (compilé sans EGL)" << std::endl;
+    return false;
+#endif
+}
+
 void Renderer::SetupOpenGL() {
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_MULTISAMPLE);
@@ -66,7 +273,163 @@ void Renderer::SetupOpenGL() {
     glClearColor(0.53f, 0.81f, 0.92f, 1.0f); // Bleu ciel
 }
 
+bool Renderer::CreateShaders() {
+    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, CUBE_VERTEX_SHADER);
+    GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, CUBE_FRAGMENT_SHADER);
+    if (!vertexShader || !fragmentShader) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    m_cubeProgram = glCreateProgram();
+    glAttachShader(m_cubeProgram, vertexShader);
+    glAttachShader(m_cubeProgram, fragmentShader);
+    glLinkProgram(m_cubeProgram);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(m_cubeProgram, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetProgramInfoLog(m_cubeProgram, sizeof(log), nullptr, log);
+        std::cerr << "Erreur programme: " << log << std::endl;
+        return false;
+    }
+    m_viewProjectionLocation = glGetUniformLocation(m_cubeProgram, "u_viewProjection");
+
+    glGenVertexArrays(1, &m_cubeVao);
+    glBindVertexArray(m_cubeVao);
+
+    // Sommets du cube unité : attribut par sommet
+    glGenBuffers(1, &m_cubeVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_cubeVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(UNIT_CUBE), UNIT_CUBE, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
+
+    // Instances : six vec3 consécutifs, avancés une fois par cube
+    glGenBuffers(1, &m_instanceVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    static_assert(sizeof(CubeInstance) == 18 * sizeof(GLfloat), "CubeInstance doit rester compact");
+    for (GLuint attribute = 0; attribute < 6; ++attribute) {
+        const GLuint location = 1 + attribute;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, sizeof(CubeInstance),
+                              reinterpret_cast<const void*>(attribute * sizeof(glm::vec3)));
+        glVertexAttribDivisor(location, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_cubeInstances.reserve(1024);
+    m_commands.Reserve(1024);
+    return true;
+}
+
+void Renderer::RenderImmediate() {
+    m_commands.Sort(m_cameraPosition);
+    glm::mat4 projection = GetProjectionMatrix();
+    glm::mat4 view = GetViewMatrix();
+
+    // Le tri a groupé les commandes par primitive : une suite = un changement d'état
+    const size_t count = m_commands.GetCount();
+    for (size_t k = 0; k < count;) {
+        const RenderPrimitive primitive = m_commands.GetSorted(k).primitive;
+        size_t end = k;
+        while (end < count && m_commands.GetSorted(end).primitive == primitive) end++;
+
+        switch (primitive) {
+            case RenderPrimitive::Cube:
+                m_cubeInstances.clear();
+                for (; k < end; ++k) {
+                    const RenderCommand& command = m_commands.GetSorted(k);
+                    m_cubeInstances.push_back({command.a, command.b, command.color,
+                                               command.axisX, command.axisY, command.axisZ});
+                }
+                DrawCubeInstances();
+                break;
+            case RenderPrimitive::Line:
+                glMatrixMode(GL_PROJECTION);
+                glLoadMatrixf(&projection[0][0]);
+                glMatrixMode(GL_MODELVIEW);
+                glLoadMatrixf(&view[0][0]);
+                glLineWidth(2.0f);
+                glBegin(GL_LINES);
+                for (; k < end; ++k) {
+                    const RenderCommand& command = m_commands.GetSorted(k);
+                    glColor3f(command.color.r, command.color.g, command.color.b);
+                    glVertex3f(command.a.x, command.a.y, command.a.z);
+                    glVertex3f(command.b.x, command.b.y, command.b.z);
+                }
+                glEnd();
+                break;
+        }
+    }
+    m_commands.Clear();
+}
+
+void Renderer::DrawCubeInstances() {
+    if (m_cubeInstances.empty()) {
+        return;
+    }
+
+    const size_t count = m_cubeInstances.size();
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(count * sizeof(CubeInstance));
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    if (count > m_instanceCapacity) {
+        // Croissance géométrique : la réallocation côté driver reste rare
+        m_instanceCapacity = std::max(count, m_instanceCapacity * 2);
+    }
+    // Réalloué (ou orpheliné) à chaque frame : le driver n'attend pas la fin du
+    // draw précédent avant de laisser écrire les nouvelles instances
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceCapacity * sizeof(CubeInstance)),
+                 nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_cubeInstances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glm::mat4 viewProjection = GetProjectionMatrix() * GetViewMatrix();
+    glUseProgram(m_cubeProgram);
+    glUniformMatrix4fv(m_viewProjectionLocation, 1, GL_FALSE, &viewProjection[0][0]);
+    glBindVertexArray(m_cubeVao);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, UNIT_CUBE_VERTICES, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
 void Renderer::Shutdown() {
+    StopCapture();
+
+    if (m_cubeProgram) {
+        // Les objets GL appartiennent au contexte : les libérer avant lui
+        glDeleteBuffers(1, &m_instanceVbo);
+        glDeleteBuffers(1, &m_cubeVbo);
+        glDeleteVertexArrays(1, &m_cubeVao);
+        glDeleteProgram(m_cubeProgram);
+        m_instanceVbo = m_cubeVbo = m_cubeVao = m_cubeProgram = 0;
+        m_instanceCapacity = 0;
+    }
+
+    if (m_offscreen) {
+#if defined(WOBBLY_HAS_EGL)
+        if (m_offscreenFbo) {
+            glDeleteRenderbuffers(1, &m_offscreenDepth);
+            glDeleteRenderbuffers(1, &m_offscreenColor);
+            glDeleteFramebuffers(1, &m_offscreenFbo);
+            m_offscreenFbo = m_offscreenColor = m_offscreenDepth = 0;
+        }
+        EGLDisplay display = static_cast<EGLDisplay>(m_eglDisplay);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_eglContext) eglDestroyContext(display, static_cast<EGLContext>(m_eglContext));
+        if (m_eglSurface) eglDestroySurface(display, static_cast<EGLSurface>(m_eglSurface));
+        eglTerminate(display);
+#endif
+        m_eglDisplay = m_eglSurface = m_eglContext = nullptr;
+        m_offscreen = false;
+        return;
+    }
+
     if (m_window) {
         glfwDestroyWindow(m_window);
         m_window = nullptr;
@@ -74,90 +437,104 @@ void Renderer::Shutdown() {
     glfwTerminate();
 }
 
-void Renderer::BeginFrame() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    // Setup matrices
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(&GetProjectionMatrix()[0][0]);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(&GetViewMatrix()[0][0]);
+bool Renderer::StartCapture(const std::string& path, CaptureFormat format) {
+    if (!m_window && !m_offscreen) {
+        std::cerr << "Erreur: Capture sans contexte OpenGL" << std::endl;
+        return false;
+    }
+    StopCapture();
+    if (!m_capture.Open(path, format, m_width, m_height, m_framesPerSecond)) {
+        return false;
+    }
+
+    const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(m_width) * m_height * 4;
+    glGenBuffers(CaptureRing, m_capturePbos);
+    for (unsigned int pbo : m_capturePbos) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_captureIssued = 0;
+    m_captureCollected = 0;
+    return true;
 }
 
-void Renderer::EndFrame() {
-    glfwSwapBuffers(m_window);
-    glfwPollEvents();
+bool Renderer::StopCapture() {
+    if (!m_capture.IsOpen()) {
+        return true;
+    }
+
+    // Les relectures en vol sont encore des images du fichier
+    while (m_captureCollected < m_captureIssued) {
+        CollectFrame();
+    }
+    glDeleteBuffers(CaptureRing, m_capturePbos);
+    std::fill(std::begin(m_capturePbos), std::end(m_capturePbos), 0u);
+
+    m_capture.Close();
+    if (m_capture.HasFailed()) {
+        std::cerr << "Erreur: Écriture de la capture incomplète (" << m_capture.GetFramesWritten() << " images sur "
+                  << m_captureIssued << ")" << std::endl;
+        return false;
+    }
+    std::cout << "🎞️  Capture : " << m_capture.GetFramesWritten() << " images écrites" << std::endl;
+    return true;
 }
 
-bool Renderer::ShouldClose() const {
-    return glfwWindowShouldClose(m_window);
+void Renderer::ReadBackFrame() {
+    // Le PBO à réutiliser contient encore la plus ancienne relecture
+    if (m_captureIssued - m_captureCollected == CaptureRing) {
+        CollectFrame();
+    }
+
+    // glReadPixels vers un PBO retourne tout de suite : la copie se fait côté driver
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_capturePbos[m_captureIssued % CaptureRing]);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_captureIssued++;
 }
 
-void Renderer::DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec3& color) {
-    glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
-    glScalef(size.x, size.y, size.z);
-    
-    glColor3f(color.r, color.g, color.b);
-    
-    // Dessin simple d'un cube (mode immediate)
-    glBegin(GL_QUADS);
-    
-    // Face avant
-    glVertex3f(-0.5f, -0.5f, 0.5f);
-    glVertex3f(0.5f, -0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, 0.5f);
-    glVertex3f(-0.5f, 0.5f, 0.5f);
-    
-    // Face arrière
-    glVertex3f(-0.5f, -0.5f, -0.5f);
-    glVertex3f(-0.5f, 0.5f, -0.5f);
-    glVertex3f(0.5f, 0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, -0.5f);
-    
-    // Face gauche
-    glVertex3f(-0.5f, -0.5f, -0.5f);
-    glVertex3f(-0.5f, -0.5f, 0.5f);
-    glVertex3f(-0.5f, 0.5f, 0.5f);
-    glVertex3f(-0.5f, 0.5f, -0.5f);
-    
-    // Face droite
-    glVertex3f(0.5f, -0.5f, -0.5f);
-    glVertex3f(0.5f, 0.5f, -0.5f);
-    glVertex3f(0.5f, 0.5f, 0.5f);
-    glVertex3f(0.5f, -0.5f, 0.5f);
-    
-    // Face dessus
-    glVertex3f(-0.5f, 0.5f, -0.5f);
-    glVertex3f(-0.5f, 0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, 0.5f);
-    glVertex3f(0.5f, 0.5f, -0.5f);
-    
-    // Face dessous
-    glVertex3f(-0.5f, -0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, -0.5f);
-    glVertex3f(0.5f, -0.5f, 0.5f);
-    glVertex3f(-0.5f, -0.5f, 0.5f);
-    
-    glEnd();
-    
-    glPopMatrix();
+void Renderer::CollectFrame() {
+    const size_t frameBytes = static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_capturePbos[m_captureCollected % CaptureRing]);
+    const void* pixels = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (pixels) {
+        uint8_t* frame = m_capture.AcquireFrame();
+        std::memcpy(frame, pixels, frameBytes);
+        m_capture.SubmitFrame(frame);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        // Image perdue : le fichier n'aura pas le nombre d'images demandé
+        m_capture.MarkFailed();
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_captureCollected++;
 }
 
-void Renderer::DrawSphere(const glm::vec3& position, float radius, const glm::vec3& color) {
-    // Simplification: dessiner une sphère avec des cubes (icosphère basique)
-    DrawCube(position, glm::vec3(radius * 2.0f), color);
+void Renderer::BeginFrame() {
+    // Les matrices sont chargées à la soumission, avec la caméra finale de la frame
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Renderer::DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color) {
-    glColor3f(color.r, color.g, color.b);
-    glLineWidth(2.0f);
-    
-    glBegin(GL_LINES);
-    glVertex3f(start.x, start.y, start.z);
-    glVertex3f(end.x, end.y, end.z);
-    glEnd();
+void Renderer::EndFrame() {
+    RenderImmediate();
+    if (m_capture.IsOpen()) {
+        ReadBackFrame();
+    }
+    m_frameIndex++;
+
+    if (m_window) {
+        glfwSwapBuffers(m_window);
+        glfwPollEvents();
+    } else if (m_offscreen) {
+        // Rien à présenter : pousser le travail au GPU sans l'attendre
+        glFlush();
+    }
+}
+
+bool Renderer::ShouldClose() const {
+    // Hors écran, c'est l'appelant qui fixe le nombre d'images
+    return m_window ? glfwWindowShouldClose(m_window) : false;
 }
 
 void Renderer::SetCameraPosition(const glm::vec3& position) {
@@ -169,7 +546,11 @@ void Renderer::SetCameraTarget(const glm::vec3& target) {
 }
 
 glm::mat4 Renderer::GetViewMatrix() const {
-    return glm::lookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
+    return GetViewMatrix(m_cameraPosition, m_cameraTarget);
+}
+
+glm::mat4 Renderer::GetViewMatrix(const glm::vec3& position, const glm::vec3& target) const {
+    return glm::lookAt(position, target, m_cameraUp);
 }
 
 glm::mat4 Renderer::GetProjectionMatrix() const {
@@ -177,6 +558,11 @@ glm::mat4 Renderer::GetProjectionMatrix() const {
 }
 
 float Renderer::GetTime() const {
+    // Hors écran, horloge d'images : une vidéo a le même contenu quelle que
+    // soit la vitesse du rendu logiciel
+    if (m_offscreen) {
+        return static_cast<float>(m_frameIndex) / static_cast<float>(m_framesPerSecond);
+    }
     return static_cast<float>(glfwGetTime());
 }
 
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "frame_capture.h"
+#include "render_commands.h"
 
 // Forward declarations (GLFW sera inclus dans le .cpp)
 struct GLFWwindow;
@@ -16,22 +20,53 @@ public:
     
     // Initialisation
     bool Initialize(int width, int height, const std::string& title);
+    // Sans fenêtre ni écran : contexte EGL (rasteriseur logiciel de Mesa sur
+    // une machine sans GPU), rendu dans un framebuffer hors écran de taille
+    // fixe. GetTime avance de 1 / framesPerSecond à chaque EndFrame.
+    bool InitializeOffscreen(int width, int height, int framesPerSecond = 60);
+    bool IsOffscreen() const { return m_offscreen; }
     void Shutdown();
+
+    // Capture de chaque image dans un fichier (raw, PPM ou Y4M). La relecture
+    // passe par un anneau de PBO, sans attendre le GPU ; conversion et écriture
+    // se font sur le thread du FrameWriter. StopCapture renvoie false si une
+    // image manque au fichier (relecture ou écriture échouée).
+    bool StartCapture(const std::string& path, CaptureFormat format);
+    bool StopCapture();
     
     // Boucle de rendu
     void BeginFrame();
     void EndFrame();
     bool ShouldClose() const;
     
-    // Primitives de rendu
-    void DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec3& color);
-    void DrawSphere(const glm::vec3& position, float radius, const glm::vec3& color);
-    void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color);
+    // Primitives de rendu : ajoutées à la liste de la frame, triée puis soumise
+    // à EndFrame (cubes, pavés et sphères en un seul appel instancié)
+    void DrawCube(const glm::vec3& position, const glm::vec3& size, const glm::vec3& color) {
+        m_commands.DrawCube(position, size, color);
+    }
+    // Pavé tourné autour de son centre (colonnes de rotation : ses axes)
+    void DrawBox(const glm::vec3& position, const glm::vec3& size, const glm::mat3& rotation, const glm::vec3& color) {
+        m_commands.DrawBox(position, size, rotation, color);
+    }
+    void DrawSphere(const glm::vec3& position, float radius, const glm::vec3& color) {
+        m_commands.DrawSphere(position, radius, color);
+    }
+    void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color) {
+        m_commands.DrawLine(start, end, color);
+    }
+
+    // Liste de la frame, à remplir directement ou par fusion des listes
+    // construites sur d'autres threads (Submit, avant EndFrame)
+    RenderCommandList& GetCommands() { return m_commands; }
+    void Submit(const RenderCommandList& commands) { m_commands.Append(commands); }
     
     // Caméra
     void SetCameraPosition(const glm::vec3& position);
     void SetCameraTarget(const glm::vec3& target);
     glm::mat4 GetViewMatrix() const;
+    // Vue d'une autre caméra, sans toucher à celle du renderer (utilisable hors
+    // du thread de rendu, comme GetProjectionMatrix)
+    glm::mat4 GetViewMatrix(const glm::vec3& position, const glm::vec3& target) const;
     glm::mat4 GetProjectionMatrix() const;
     
     // Utilitaires
@@ -39,11 +74,56 @@ public:
     float GetTime() const;
     
 private:
+    // Une instance du cube unité : centre, dimensions, couleur puis les trois
+    // colonnes de rotation (identité pour DrawCube), lues telles quelles par le
+    // vertex shader
+    struct CubeInstance {
+        glm::vec3 position;
+        glm::vec3 size;
+        glm::vec3 color;
+        glm::vec3 axisX;
+        glm::vec3 axisY;
+        glm::vec3 axisZ;
+    };
+
     void SetupOpenGL();
-    void CreateShaders();
-    void RenderImmediate(); // Mode immediate pour simplicité
+    bool CreateShaders();
+    void RenderImmediate(); // Trie et soumet la liste de la frame en une passe
+    void DrawCubeInstances(); // Un seul draw call pour m_cubeInstances
+    void ReadBackFrame(); // Lance la relecture de l'image dessinée
+    void CollectFrame();  // Passe au FrameWriter la plus ancienne relecture en vol
     
     GLFWwindow* m_window = nullptr;
+
+    // Cube unité chargé une fois, instances renvoyées à chaque frame
+    unsigned int m_cubeProgram = 0;
+    unsigned int m_cubeVao = 0;
+    unsigned int m_cubeVbo = 0;
+    unsigned int m_instanceVbo = 0;
+    size_t m_instanceCapacity = 0; // Taille allouée de m_instanceVbo (instances)
+    int m_viewProjectionLocation = -1;
+    std::vector<CubeInstance> m_cubeInstances;
+
+    RenderCommandList m_commands;
+
+    // Hors écran : objets EGL (opaques ici) et framebuffer cible
+    bool m_offscreen = false;
+    void* m_eglDisplay = nullptr;
+    void* m_eglSurface = nullptr;
+    void* m_eglContext = nullptr;
+    unsigned int m_offscreenFbo = 0;
+    unsigned int m_offscreenColor = 0;
+    unsigned int m_offscreenDepth = 0;
+    int m_framesPerSecond = 60;
+    uint64_t m_frameIndex = 0;
+
+    // Capture : une relecture est récupérée quand son PBO doit resservir,
+    // CaptureRing images plus tard (le transfert est fini depuis longtemps)
+    static constexpr int CaptureRing = 3;
+    unsigned int m_capturePbos[CaptureRing] = {};
+    uint64_t m_captureIssued = 0;
+    uint64_t m_captureCollected = 0;
+    FrameWriter m_capture;
     
     // Caméra
     glm::vec3 m_cameraPosition{0.0f, 5.0f, -10.0f};
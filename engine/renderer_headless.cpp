@@ -0,0 +1,79 @@
+#include "renderer.h"
+#include <chrono>
+
+// Renderer sans fenêtre ni OpenGL, lié à la place de renderer.cpp par les
+// cibles headless (wobbly_bench) : même interface, la liste de commandes est
+// vidée à chaque frame sans être dessinée.
+
+namespace Engine {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+const Clock::time_point START_TIME = Clock::now();
+
+} // namespace
+
+Renderer::Renderer() {}
+
+Renderer::~Renderer() {}
+
+bool Renderer::Initialize(int width, int height, const std::string&) {
+    m_width = width;
+    m_height = height;
+    m_aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    return true;
+}
+
+bool Renderer::InitializeOffscreen(int width, int height, int framesPerSecond) {
+    m_framesPerSecond = framesPerSecond;
+    m_offscreen = true;
+    return Initialize(width, height, std::string());
+}
+
+void Renderer::Shutdown() {}
+
+bool Renderer::StartCapture(const std::string&, CaptureFormat) {
+    // Aucune image à relire
+    return false;
+}
+
+bool Renderer::StopCapture() {
+    return true;
+}
+
+void Renderer::BeginFrame() {}
+
+void Renderer::EndFrame() {
+    m_commands.Clear();
+}
+
+bool Renderer::ShouldClose() const {
+    return false;
+}
+
+void Renderer::SetCameraPosition(const glm::vec3& position) {
+    m_cameraPosition = position;
+}
+
+void Renderer::SetCameraTarget(const glm::vec3& target) {
+    m_cameraTarget = target;
+}
+
+glm::mat4 Renderer::GetViewMatrix() const {
+    return GetViewMatrix(m_cameraPosition, m_cameraTarget);
+}
+
+glm::mat4 Renderer::GetViewMatrix(const glm::vec3& position, const glm::vec3& target) const {
+    return glm::lookAt(position, target, m_cameraUp);
+}
+
+glm::mat4 Renderer::GetProjectionMatrix() const {
+    return glm::perspective(glm::radians(m_fov), m_aspectRatio, m_nearPlane, m_farPlane);
+}
+
+float Renderer::GetTime() const {
+    return std::chrono::duration<float>(Clock::now() - START_TIME).count();
+}
+
+} // namespace Engine
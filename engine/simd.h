@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define WOBBLY_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+// Les fonctions SIMD sont compilées pour leur cible sans changer les options
+// du reste du fichier ; le choix se fait à l'exécution (SimdLevel)
+#if defined(WOBBLY_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define WOBBLY_TARGET_SSE41 __attribute__((target("sse4.1")))
+    #define WOBBLY_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define WOBBLY_TARGET_SSE41
+    #define WOBBLY_TARGET_AVX2
+#endif
+
+#if defined(WOBBLY_X86)
+
+namespace Engine {
+
+// Masque de voie : flags[k] & bit, pour 4 (SSE) ou 8 (AVX2) corps consécutifs
+WOBBLY_TARGET_SSE41
+inline __m128 LoadFlagMaskSSE(const uint8_t* flags, int bit) {
+    int32_t packed;
+    std::memcpy(&packed, flags, sizeof(packed));
+    __m128i lanes = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+    __m128i mask = _mm_set1_epi32(bit);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(lanes, mask), mask));
+}
+
+WOBBLY_TARGET_AVX2
+inline __m256 LoadFlagMaskAVX2(const uint8_t* flags, int bit) {
+    __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags)));
+    __m256i mask = _mm256_set1_epi32(bit);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(lanes, mask), mask));
+}
+
+} // namespace Engine
+
+#endif // WOBBLY_X86
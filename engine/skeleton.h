@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "body_store.h"
+
+// SSE2 fait partie de toute cible x86-64 : pas de choix à l'exécution
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define WOBBLY_SKELETON_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace Engine {
+
+// Articulation d'un squelette, entre deux parties de sa topologie
+struct SkeletonJoint {
+    uint8_t parent = 0;
+    uint8_t child = 0;
+    float restLength = 0.0f;
+    float stiffness = 0.8f;  // Solveur itératif (comme Constraint)
+    float compliance = 0.0f; // Solveur XPBD
+};
+
+// Topologie fixe décrite par une table constexpr : le solveur est instancié
+// pour elle et connaît à la compilation le nombre de parties et chaque joint
+template <size_t Parts, size_t Joints>
+struct SkeletonTopology {
+    static constexpr size_t PartCount = Parts;
+    static constexpr size_t JointCount = Joints;
+    SkeletonJoint joints[Joints];
+};
+
+struct SkeletonSolveParams {
+    bool xpbd = false;
+    float complianceScale = 0.0f; // XPBD : 1 / h²
+};
+
+// Une passe sur count squelettes ; dense et inverseMass contiennent PartCount
+// valeurs par squelette. Retourne le plus grand écart de longueur (m).
+using SkeletonSolveFn = float (*)(BodyStore& bodies, const uint32_t* dense, const float* inverseMass,
+                                  size_t count, const SkeletonSolveParams& params);
+
+// Squelettes d'une même topologie, enregistrés auprès du moteur
+struct SkeletonGroup {
+    const void* topology = nullptr;
+    size_t partCount = 0;
+    std::vector<SkeletonJoint> joints;     // Copie pour les îlots et le filtre de collision
+    SkeletonSolveFn solve = nullptr;
+    std::vector<BodyHandle> bodies;        // partCount handles par squelette
+    std::vector<uint32_t> awakeDense;      // Indices denses des squelettes éveillés
+    std::vector<float> awakeInverseMass;   // 0 pour un corps cinématique
+    std::vector<size_t> awakeSlots;        // Premier squelette éveillé de chaque créneau LOD
+};
+
+namespace detail {
+
+// Squelettes résolus de front, un par voie : les joints d'un squelette
+// s'enchaînent (torse, bassin...), ceux de squelettes différents sont
+// indépendants. Les voies inutilisées ont un poids nul et ne bougent pas.
+constexpr size_t SKELETON_LANES = 4;
+
+template <size_t P>
+struct SkeletonPacket {
+    alignas(16) float x[P][SKELETON_LANES];
+    alignas(16) float y[P][SKELETON_LANES];
+    alignas(16) float z[P][SKELETON_LANES];
+    alignas(16) float weight[P][SKELETON_LANES];
+};
+
+// Chemin scalaire (référence). Itératif : part fixe de l'erreur, partagée
+// entre les corps mobiles ; XPBD : dlambda = -C / (wA + wB + compliance / h²).
+// Une seule division : la normalisation de (dx, dy, dz) y est incluse.
+template <const auto& Topology, size_t J, size_t P>
+inline float SolveSkeletonJoint(SkeletonPacket<P>& k, const SkeletonSolveParams& params) {
+    constexpr SkeletonJoint joint = Topology.joints[J];
+    constexpr size_t a = joint.parent;
+    constexpr size_t b = joint.child;
+    static_assert(a < P && b < P, "squelette : partie hors de la topologie");
+
+    float maxError = 0.0f;
+    for (size_t l = 0; l < SKELETON_LANES; ++l) {
+        float weightSum = k.weight[a][l] + k.weight[b][l];
+        float dx = k.x[b][l] - k.x[a][l];
+        float dy = k.y[b][l] - k.y[a][l];
+        float dz = k.z[b][l] - k.z[a][l];
+        float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (!(weightSum > 0.0f && distance >= 0.0001f)) continue;
+
+        float error = distance - joint.restLength;
+        float scale = params.xpbd ? error / ((weightSum + joint.compliance * params.complianceScale) * distance)
+                                  : error * joint.stiffness / (weightSum * distance);
+
+        k.x[a][l] = k.x[a][l] + dx * scale * k.weight[a][l];
+        k.y[a][l] = k.y[a][l] + dy * scale * k.weight[a][l];
+        k.z[a][l] = k.z[a][l] + dz * scale * k.weight[a][l];
+        k.x[b][l] = k.x[b][l] - dx * scale * k.weight[b][l];
+        k.y[b][l] = k.y[b][l] - dy * scale * k.weight[b][l];
+        k.z[b][l] = k.z[b][l] - dz * scale * k.weight[b][l];
+        maxError = std::max(maxError, std::abs(error));
+    }
+    return maxError;
+}
+
+template <const auto& Topology, size_t P, size_t... J>
+inline float SolveSkeletonPacket(SkeletonPacket<P>& k, const SkeletonSolveParams& params, std::index_sequence<J...>) {
+    float maxError = 0.0f;
+    ((maxError = std::max(maxError, SolveSkeletonJoint<Topology, J>(k, params))), ...);
+    return maxError;
+}
+
+#if defined(WOBBLY_SKELETON_SSE)
+// Chemin SSE : mêmes opérations que le chemin scalaire, dans le même ordre,
+// sur les quatre voies à la fois (résultats identiques). Les voies inactives
+// sont masquées plutôt que sautées.
+template <const auto& Topology, size_t J, size_t P>
+inline __m128 SolveSkeletonJointSse(SkeletonPacket<P>& k, const SkeletonSolveParams& params) {
+    constexpr SkeletonJoint joint = Topology.joints[J];
+    constexpr size_t a = joint.parent;
+    constexpr size_t b = joint.child;
+    static_assert(a < P && b < P, "squelette : partie hors de la topologie");
+
+    const __m128 weightA = _mm_load_ps(k.weight[a]);
+    const __m128 weightB = _mm_load_ps(k.weight[b]);
+    const __m128 weightSum = _mm_add_ps(weightA, weightB);
+    __m128 xa = _mm_load_ps(k.x[a]), ya = _mm_load_ps(k.y[a]), za = _mm_load_ps(k.z[a]);
+    __m128 xb = _mm_load_ps(k.x[b]), yb = _mm_load_ps(k.y[b]), zb = _mm_load_ps(k.z[b]);
+    const __m128 dx = _mm_sub_ps(xb, xa);
+    const __m128 dy = _mm_sub_ps(yb, ya);
+    const __m128 dz = _mm_sub_ps(zb, za);
+    const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                                   _mm_mul_ps(dz, dz)));
+    const __m128 active = _mm_and_ps(_mm_cmpgt_ps(weightSum, _mm_setzero_ps()),
+                                     _mm_cmpge_ps(distance, _mm_set1_ps(0.0001f)));
+
+    const __m128 error = _mm_sub_ps(distance, _mm_set1_ps(joint.restLength));
+    __m128 scale;
+    if (params.xpbd) {
+        const __m128 compliance = _mm_set1_ps(joint.compliance * params.complianceScale);
+        scale = _mm_div_ps(error, _mm_mul_ps(_mm_add_ps(weightSum, compliance), distance));
+    } else {
+        scale = _mm_div_ps(_mm_mul_ps(error, _mm_set1_ps(joint.stiffness)), _mm_mul_ps(weightSum, distance));
+    }
+    scale = _mm_and_ps(active, scale);
+
+    const __m128 sx = _mm_mul_ps(dx, scale);
+    const __m128 sy = _mm_mul_ps(dy, scale);
+    const __m128 sz = _mm_mul_ps(dz, scale);
+    _mm_store_ps(k.x[a], _mm_add_ps(xa, _mm_mul_ps(sx, weightA)));
+    _mm_store_ps(k.y[a], _mm_add_ps(ya, _mm_mul_ps(sy, weightA)));
+    _mm_store_ps(k.z[a], _mm_add_ps(za, _mm_mul_ps(sz, weightA)));
+    _mm_store_ps(k.x[b], _mm_sub_ps(xb, _mm_mul_ps(sx, weightB)));
+    _mm_store_ps(k.y[b], _mm_sub_ps(yb, _mm_mul_ps(sy, weightB)));
+    _mm_store_ps(k.z[b], _mm_sub_ps(zb, _mm_mul_ps(sz, weightB)));
+
+    const __m128 absError = _mm_andnot_ps(_mm_set1_ps(-0.0f), error);
+    return _mm_and_ps(active, absError);
+}
+
+template <const auto& Topology, size_t P, size_t... J>
+inline float SolveSkeletonPacketSse(SkeletonPacket<P>& k, const SkeletonSolveParams& params, std::index_sequence<J...>) {
+    __m128 maxError = _mm_setzero_ps();
+    ((maxError = _mm_max_ps(maxError, SolveSkeletonJointSse<Topology, J>(k, params))), ...);
+    alignas(16) float lanes[SKELETON_LANES];
+    _mm_store_ps(lanes, maxError);
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+#endif
+
+} // namespace detail
+
+// Solveur d'une topologie : les squelettes sont chargés par paquets dans des
+// tableaux locaux de taille fixe, les joints sont résolus dans l'ordre de la
+// table (boucle déroulée, indices constants), puis les positions sont réécrites.
+// Les squelettes ne partagent aucun corps : l'ordre entre eux n'importe pas.
+template <const auto& Topology>
+float SolveSkeletons(BodyStore& bodies, const uint32_t* dense, const float* inverseMass, size_t count,
+                     const SkeletonSolveParams& params) {
+    using TopologyType = std::decay_t<decltype(Topology)>;
+    constexpr size_t P = TopologyType::PartCount;
+    constexpr size_t L = detail::SKELETON_LANES;
+    using Joints = std::make_index_sequence<TopologyType::JointCount>;
+
+    detail::SkeletonPacket<P> k = {};
+    float maxError = 0.0f;
+    for (size_t first = 0; first < count; first += L) {
+        const size_t lanes = std::min(L, count - first);
+        const uint32_t* packet = dense + first * P;
+        const float* packetMass = inverseMass + first * P;
+
+        for (size_t l = 0; l < lanes; ++l) {
+            for (size_t p = 0; p < P; ++p) {
+                uint32_t i = packet[l * P + p];
+                k.x[p][l] = bodies.posX[i];
+                k.y[p][l] = bodies.posY[i];
+                k.z[p][l] = bodies.posZ[i];
+                // Itératif : 50/50 entre corps mobiles ; XPBD : pondéré par la masse
+                float w = packetMass[l * P + p];
+                k.weight[p][l] = params.xpbd ? w : (w > 0.0f ? 1.0f : 0.0f);
+            }
+        }
+        for (size_t l = lanes; l < L; ++l) {
+            for (size_t p = 0; p < P; ++p) {
+                k.weight[p][l] = 0.0f;
+            }
+        }
+
+#if defined(WOBBLY_SKELETON_SSE)
+        maxError = std::max(maxError, detail::SolveSkeletonPacketSse<Topology>(k, params, Joints{}));
+#else
+        maxError = std::max(maxError, detail::SolveSkeletonPacket<Topology>(k, params, Joints{}));
+#endif
+
+        for (size_t l = 0; l < lanes; ++l) {
+            for (size_t p = 0; p < P; ++p) {
+                uint32_t i = packet[l * P + p];
+                bodies.posX[i] = k.x[p][l];
+                bodies.posY[i] = k.y[p][l];
+                bodies.posZ[i] = k.z[p][l];
+            }
+        }
+    }
+    return maxError;
+}
+
+} // namespace Engine
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+
+// État de simulation sérialisé : une suite de valeurs et de tableaux copiés
+// tels quels (memcpy). Valable uniquement pour le même binaire.
+using SnapshotBlob = std::vector<uint8_t>;
+
+class SnapshotWriter {
+public:
+    // Le tampon est vidé mais garde sa capacité : pas d'allocation en régime établi
+    explicit SnapshotWriter(SnapshotBlob& blob) : m_blob(blob) { m_blob.clear(); }
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: type non copiable");
+        Append(&value, sizeof(T));
+    }
+
+    // Taille puis contenu brut d'un tableau contigu
+    template <typename Vector>
+    void WriteArray(const Vector& array) {
+        using T = typename Vector::value_type;
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: type non copiable");
+        uint64_t count = array.size();
+        Write(count);
+        Append(array.data(), count * sizeof(T));
+    }
+
+private:
+    void Append(const void* data, size_t bytes) {
+        const uint8_t* bytesIn = static_cast<const uint8_t*>(data);
+        m_blob.insert(m_blob.end(), bytesIn, bytesIn + bytes);
+    }
+
+    SnapshotBlob& m_blob;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const SnapshotBlob& blob) : m_blob(blob) {}
+
+    // Faux dès qu'une lecture dépasse le tampon ; les lectures suivantes échouent aussi
+    bool IsValid() const { return m_valid; }
+    bool AtEnd() const { return m_offset == m_blob.size(); }
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: type non copiable");
+        return Extract(&value, sizeof(T));
+    }
+
+    template <typename Vector>
+    bool ReadArray(Vector& array) {
+        using T = typename Vector::value_type;
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot: type non copiable");
+        uint64_t count = 0;
+        if (!Read(count) || count > (m_blob.size() - m_offset) / sizeof(T)) {
+            m_valid = false;
+            return false;
+        }
+        array.resize(static_cast<size_t>(count));
+        return Extract(array.data(), static_cast<size_t>(count) * sizeof(T));
+    }
+
+private:
+    bool Extract(void* data, size_t bytes) {
+        if (!m_valid || bytes > m_blob.size() - m_offset) {
+            m_valid = false;
+            return false;
+        }
+        if (bytes > 0) {
+            std::memcpy(data, m_blob.data() + m_offset, bytes);
+        }
+        m_offset += bytes;
+        return true;
+    }
+
+    const SnapshotBlob& m_blob;
+    size_t m_offset = 0;
+    bool m_valid = true;
+};
+
+} // namespace Engine
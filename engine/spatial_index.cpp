@@ -0,0 +1,48 @@
+#include "spatial_index.h"
+
+namespace Engine {
+
+void SpatialIndex::Rebuild(const BodyStore& bodies) {
+    m_entries.clear();
+    m_maxLengthZ = 0.0f;
+
+    const uint32_t count = static_cast<uint32_t>(bodies.Size());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (bodies.IsStatic(i)) continue;
+        Entry entry;
+        entry.body = bodies.HandleAt(i);
+        UpdateBounds(bodies, entry, i);
+        m_entries.push_back(entry);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+        return a.min.z < b.min.z || (a.min.z == b.min.z && a.body.index < b.body.index);
+    });
+}
+
+void SpatialIndex::Refresh(const BodyStore& bodies) {
+    m_maxLengthZ = 0.0f;
+    for (Entry& entry : m_entries) {
+        UpdateBounds(bodies, entry, bodies.DenseIndex(entry.body));
+    }
+
+    // D'une frame à l'autre l'ordre change peu : tri par insertion en O(n)
+    for (size_t i = 1; i < m_entries.size(); ++i) {
+        Entry current = m_entries[i];
+        size_t j = i;
+        while (j > 0 && current.min.z < m_entries[j - 1].min.z) {
+            m_entries[j] = m_entries[j - 1];
+            --j;
+        }
+        m_entries[j] = current;
+    }
+}
+
+void SpatialIndex::UpdateBounds(const BodyStore& bodies, Entry& entry, uint32_t i) {
+    glm::vec3 position = bodies.Position(i);
+    entry.min = position + bodies.BoxMin(i);
+    entry.max = position + bodies.BoxMax(i);
+    m_maxLengthZ = std::max(m_maxLengthZ, entry.max.z - entry.min.z);
+}
+
+} // namespace Engine
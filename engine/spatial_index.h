@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <glm/glm.hpp>
+#include "body_store.h"
+
+namespace Engine {
+
+// Filtre des requêtes spatiales (Raycast, OverlapAABB, SweepAABB)
+struct QueryFilter {
+    bool staticBodies = true;  // Géométrie fixe du niveau
+    bool dynamicBodies = true; // Tous les autres corps, cinématiques et endormis compris
+    bool ground = true;        // Sol du moteur, Heightfield (Raycast et SweepAABB seulement)
+    const BodyHandle* ignore = nullptr; // Corps à ignorer (ex. les parties du joueur)
+    size_t ignoreCount = 0;
+
+    bool Ignores(BodyHandle body) const {
+        return std::find(ignore, ignore + ignoreCount, body) != ignore + ignoreCount;
+    }
+};
+
+// Premier impact d'un rayon. body est invalide pour le sol.
+struct RaycastHit {
+    BodyHandle body;
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f};
+    float distance = 0.0f;
+};
+
+// Premier impact d'une boîte balayée : elle touche après fraction * delta
+struct SweepHit {
+    BodyHandle body;
+    glm::vec3 normal{0.0f};
+    float fraction = 0.0f;
+};
+
+// Segment origin + t * delta, préparé une fois par requête (inverses des
+// composantes) puis testé contre de nombreuses AABB
+struct Segment {
+    glm::vec3 origin;
+    glm::vec3 delta;
+    glm::vec3 inverse;
+
+    Segment(const glm::vec3& from, const glm::vec3& d) : origin(from), delta(d) {
+        for (int a = 0; a < 3; ++a) {
+            inverse[a] = d[a] != 0.0f ? 1.0f / d[a] : 0.0f;
+        }
+    }
+};
+
+// Segment (t dans [0, maxT]) contre une AABB. Vrai si touchée : t d'entrée
+// et axe d'entrée (-1 si l'origine est dedans, t = 0).
+inline bool IntersectSegmentBox(const Segment& segment, float maxT,
+                                const glm::vec3& boxMin, const glm::vec3& boxMax, float& t, int& axis) {
+    float enter = 0.0f;
+    float exit = maxT;
+    axis = -1;
+    for (int a = 0; a < 3; ++a) {
+        if (segment.delta[a] == 0.0f) {
+            // Parallèle aux faces : dedans ou jamais
+            if (segment.origin[a] < boxMin[a] || segment.origin[a] > boxMax[a]) return false;
+            continue;
+        }
+        float near = (boxMin[a] - segment.origin[a]) * segment.inverse[a];
+        float far = (boxMax[a] - segment.origin[a]) * segment.inverse[a];
+        if (near > far) std::swap(near, far);
+        if (near > enter) {
+            enter = near;
+            axis = a;
+        }
+        exit = std::min(exit, far);
+        if (enter > exit) return false;
+    }
+    t = enter;
+    return true;
+}
+
+// Normale de la face d'entrée (opposée au mouvement sur cet axe)
+inline glm::vec3 EntryNormal(const glm::vec3& delta, int axis) {
+    glm::vec3 normal(0.0f);
+    if (axis < 0) {
+        float length = glm::length(delta);
+        return length > 0.0f ? -delta / length : normal;
+    }
+    normal[axis] = delta[axis] > 0.0f ? -1.0f : 1.0f;
+    return normal;
+}
+
+// Index des corps non statiques pour les requêtes : AABB copiées et triées
+// par début d'intervalle sur Z (l'axe du parcours). Une requête cherche le
+// premier candidat par dichotomie, recule de la plus grande longueur sur Z,
+// puis s'arrête dès que les débuts dépassent sa fin.
+// La statique est dans le BVH de StaticGeometry.
+class SpatialIndex {
+public:
+    // Reconstruction complète (corps ajoutés ou retirés, instantané restauré)
+    void Rebuild(const BodyStore& bodies);
+    // Mêmes corps, positions changées : tri par insertion sur l'ordre précédent
+    void Refresh(const BodyStore& bodies);
+
+    size_t GetEntryCount() const { return m_entries.size(); }
+
+    // Appelle fn(handle) pour chaque corps dont l'AABB touche [boxMin, boxMax]
+    template <typename Fn>
+    void Query(const glm::vec3& boxMin, const glm::vec3& boxMax, Fn&& fn) const {
+        for (size_t k = FirstCandidate(boxMin.z); k < m_entries.size() && m_entries[k].min.z <= boxMax.z; ++k) {
+            const Entry& entry = m_entries[k];
+            if (entry.min.x <= boxMax.x && entry.max.x >= boxMin.x &&
+                entry.min.y <= boxMax.y && entry.max.y >= boxMin.y &&
+                entry.max.z >= boxMin.z) {
+                fn(entry.body);
+            }
+        }
+    }
+
+    // Segment (t dans [0, maxT]) contre les AABB élargies de expand :
+    // fn(handle, t, axis) pour chaque corps touché ; fn peut réduire maxT
+    // pour ne garder que les impacts plus proches
+    template <typename Fn>
+    void Cast(const Segment& segment, const glm::vec3& expand, float& maxT, Fn&& fn) const {
+        float endZ = segment.origin.z + segment.delta.z * maxT;
+        float lowZ = std::min(segment.origin.z, endZ) - expand.z;
+        float highZ = std::max(segment.origin.z, endZ) + expand.z;
+        for (size_t k = FirstCandidate(lowZ); k < m_entries.size() && m_entries[k].min.z <= highZ; ++k) {
+            const Entry& entry = m_entries[k];
+            float t = 0.0f;
+            int axis = -1;
+            if (IntersectSegmentBox(segment, maxT, entry.min - expand, entry.max + expand, t, axis)) {
+                fn(entry.body, t, axis);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        glm::vec3 min;
+        glm::vec3 max;
+        BodyHandle body;
+    };
+
+    // Premier corps dont l'intervalle Z peut finir après minZ
+    size_t FirstCandidate(float minZ) const {
+        float from = minZ - m_maxLengthZ;
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), from,
+                                   [](const Entry& entry, float z) { return entry.min.z < z; });
+        return static_cast<size_t>(it - m_entries.begin());
+    }
+
+    void UpdateBounds(const BodyStore& bodies, Entry& entry, uint32_t i);
+
+    std::vector<Entry> m_entries;
+    float m_maxLengthZ = 0.0f;
+};
+
+} // namespace Engine
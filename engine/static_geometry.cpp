@@ -0,0 +1,78 @@
+#include "static_geometry.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Engine {
+
+void StaticGeometry::Build(const BodyStore& bodies, const std::vector<BodyHandle>& shapes) {
+    Clear();
+
+    for (BodyHandle handle : shapes) {
+        if (!bodies.IsAlive(handle)) continue;
+        uint32_t i = bodies.DenseIndex(handle);
+        m_shapes.push_back(handle);
+        m_shapeMin.push_back(bodies.Position(i) + bodies.BoxMin(i));
+        m_shapeMax.push_back(bodies.Position(i) + bodies.BoxMax(i));
+    }
+    if (m_shapes.empty()) return;
+
+    std::vector<uint32_t> order(m_shapes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    m_nodes.reserve(m_shapes.size() * 2 - 1);
+    BuildRange(order.data(), order.data() + order.size());
+
+    m_shapeMin.clear();
+    m_shapeMax.clear();
+}
+
+void StaticGeometry::Clear() {
+    m_nodes.clear();
+    m_shapes.clear();
+    m_shapeMin.clear();
+    m_shapeMax.clear();
+}
+
+void StaticGeometry::SaveState(SnapshotWriter& writer) const {
+    writer.WriteArray(m_nodes);
+    writer.WriteArray(m_shapes);
+}
+
+bool StaticGeometry::LoadState(SnapshotReader& reader) {
+    reader.ReadArray(m_nodes);
+    reader.ReadArray(m_shapes);
+    return reader.IsValid();
+}
+
+void StaticGeometry::BuildRange(uint32_t* begin, uint32_t* end) {
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back(Node());
+
+    glm::vec3 boundsMin = m_shapeMin[*begin];
+    glm::vec3 boundsMax = m_shapeMax[*begin];
+    for (uint32_t* it = begin + 1; it != end; ++it) {
+        boundsMin = glm::min(boundsMin, m_shapeMin[*it]);
+        boundsMax = glm::max(boundsMax, m_shapeMax[*it]);
+    }
+    m_nodes[index].min = boundsMin;
+    m_nodes[index].max = boundsMax;
+
+    if (end - begin == 1) {
+        m_nodes[index].shape = *begin;
+    } else {
+        // Coupe médiane des centres sur l'axe le plus long
+        glm::vec3 extent = boundsMax - boundsMin;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        uint32_t* middle = begin + (end - begin) / 2;
+        std::nth_element(begin, middle, end, [this, axis](uint32_t a, uint32_t b) {
+            return m_shapeMin[a][axis] + m_shapeMax[a][axis] < m_shapeMin[b][axis] + m_shapeMax[b][axis];
+        });
+
+        m_nodes[index].shape = NoShape;
+        BuildRange(begin, middle);
+        BuildRange(middle, end);
+    }
+
+    m_nodes[index].skip = static_cast<uint32_t>(m_nodes.size());
+}
+
+} // namespace Engine
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "body_store.h"
+#include "snapshot.h"
+#include "spatial_index.h"
+
+namespace Engine {
+
+// Géométrie statique du niveau (sol, plateformes, rampes) : BVH aplati,
+// construit une fois quand le niveau est généré. Les nœuds sont rangés en
+// profondeur d'abord ; un nœud rejeté saute directement à la fin de son
+// sous-arbre, sans pile.
+class StaticGeometry {
+public:
+    // Les AABB des corps sont copiées : à reconstruire si l'un d'eux bouge
+    void Build(const BodyStore& bodies, const std::vector<BodyHandle>& shapes);
+    void Clear();
+
+    size_t GetShapeCount() const { return m_shapes.size(); }
+
+    void SaveState(SnapshotWriter& writer) const;
+    bool LoadState(SnapshotReader& reader);
+
+    // Appelle fn(handle) pour chaque forme dont l'AABB touche [boxMin, boxMax]
+    // (contact compris, comme CheckCollision)
+    template <typename Fn>
+    void Query(const glm::vec3& boxMin, const glm::vec3& boxMax, Fn&& fn) const {
+        const uint32_t count = static_cast<uint32_t>(m_nodes.size());
+        uint32_t i = 0;
+        while (i < count) {
+            const Node& node = m_nodes[i];
+            bool overlap = node.min.x <= boxMax.x && node.max.x >= boxMin.x &&
+                           node.min.y <= boxMax.y && node.max.y >= boxMin.y &&
+                           node.min.z <= boxMax.z && node.max.z >= boxMin.z;
+            if (!overlap) {
+                i = node.skip;
+                continue;
+            }
+            if (node.shape != NoShape) {
+                fn(m_shapes[node.shape]);
+            }
+            ++i;
+        }
+    }
+
+    // Segment (t dans [0, maxT]) contre les AABB élargies de expand :
+    // fn(handle, t, axis) pour chaque forme touchée. fn peut réduire maxT :
+    // les sous-arbres plus lointains sont alors sautés.
+    template <typename Fn>
+    void Cast(const Segment& segment, const glm::vec3& expand, float& maxT, Fn&& fn) const {
+        const uint32_t count = static_cast<uint32_t>(m_nodes.size());
+        uint32_t i = 0;
+        while (i < count) {
+            const Node& node = m_nodes[i];
+            float t = 0.0f;
+            int axis = -1;
+            if (!IntersectSegmentBox(segment, maxT, node.min - expand, node.max + expand, t, axis)) {
+                i = node.skip;
+                continue;
+            }
+            if (node.shape != NoShape) {
+                fn(m_shapes[node.shape], t, axis);
+            }
+            ++i;
+        }
+    }
+
+private:
+    static constexpr uint32_t NoShape = 0xFFFFFFFFu;
+
+    struct Node {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint32_t skip;  // Premier nœud après ce sous-arbre
+        uint32_t shape; // Feuille : indice dans m_shapes, sinon NoShape
+    };
+
+    void BuildRange(uint32_t* begin, uint32_t* end);
+
+    std::vector<Node> m_nodes;
+    std::vector<BodyHandle> m_shapes;
+    std::vector<glm::vec3> m_shapeMin, m_shapeMax; // Pendant la construction
+};
+
+} // namespace Engine
@@ -0,0 +1,95 @@
+#include "thread_pool.h"
+
+namespace Engine {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for (size_t i = 1; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Run(size_t taskCount, const std::function<void(size_t)>& task) {
+    if (taskCount == 0) return;
+
+    // Pas de workers ou une seule tâche : rien à synchroniser
+    if (m_workers.empty() || taskCount == 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        // Attendre qu'aucun worker ne traîne encore sur l'appel précédent
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_active == 0; });
+
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_pending.store(taskCount, std::memory_order_relaxed);
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    // Le thread appelant travaille aussi
+    Drain(task, taskCount);
+
+    while (m_pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body) {
+    if (count == 0) return;
+
+    size_t chunks = std::min(count, GetThreadCount());
+    Run(chunks, [&](size_t chunk) {
+        body(count * chunk / chunks, count * (chunk + 1) / chunks);
+    });
+}
+
+void ThreadPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+        if (m_stop) return;
+
+        seenGeneration = m_generation;
+        const std::function<void(size_t)>* task = m_task;
+        size_t taskCount = m_taskCount;
+        ++m_active;
+        lock.unlock();
+
+        Drain(*task, taskCount);
+
+        lock.lock();
+        if (--m_active == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
+
+void ThreadPool::Drain(const std::function<void(size_t)>& task, size_t taskCount) {
+    for (;;) {
+        size_t index = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (index >= taskCount) return;
+        task(index);
+        m_pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+} // namespace Engine
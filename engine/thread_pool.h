@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+
+// Pool de threads persistants pour les boucles parallèles du moteur.
+// Le thread appelant participe au travail ; chaque appel est bloquant.
+class ThreadPool {
+public:
+    // threadCount inclut le thread appelant (1 = tout en série)
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t GetThreadCount() const { return m_workers.size() + 1; }
+
+    // Exécute task(i) pour i dans [0, taskCount), réparti dynamiquement
+    void Run(size_t taskCount, const std::function<void(size_t)>& task);
+
+    // Découpe [0, count) en un bloc contigu par thread : la répartition ne
+    // dépend que de count et du nombre de threads
+    void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body);
+
+private:
+    void WorkerLoop();
+    void Drain(const std::function<void(size_t)>& task, size_t taskCount);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextTask{0};
+    std::atomic<size_t> m_pending{0};
+    uint64_t m_generation = 0;
+    size_t m_active = 0; // Workers encore dans l'appel en cours
+    bool m_stop = false;
+};
+
+} // namespace Engine
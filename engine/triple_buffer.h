@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Engine {
+
+// Échange sans verrou entre un producteur et un consommateur : le producteur
+// remplit son tampon puis le publie, le consommateur prend toujours le dernier
+// publié. Aucun des deux n'attend l'autre ; les tampons gardent leur capacité
+// d'une publication à l'autre.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producteur : tampon à remplir (contenu d'une publication ancienne)
+    T& GetWriteBuffer() { return m_buffers[m_write]; }
+
+    // Producteur : rend le tampon rempli visible et en reprend un libre
+    void Publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_write | FRESH_BIT), std::memory_order_acq_rel);
+        m_write = previous & INDEX_MASK;
+    }
+
+    // Consommateur : passe au dernier tampon publié ; false si rien de nouveau
+    // (le tampon lu reste alors valide)
+    bool Acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+        uint8_t previous = m_middle.exchange(m_read, std::memory_order_acq_rel);
+        m_read = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Consommateur : tampon lu, immuable jusqu'au prochain Acquire
+    const T& GetReadBuffer() const { return m_buffers[m_read]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4; // Publié et pas encore pris
+
+    T m_buffers[3];
+    std::atomic<uint8_t> m_middle{1};
+    uint8_t m_write = 0; // Producteur seulement
+    uint8_t m_read = 2;  // Consommateur seulement
+};
+
+} // namespace Engine
@@ -1,11 +1,31 @@
 #include "level.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 
 namespace Game {
 
-Level::Level(Engine::PhysicsEngine* physics)
-    : m_physics(physics) {
+namespace {
+
+const float LANE_HALF_WIDTH = 10.0f;
+const float TERRAIN_CELL = 1.0f;
+const float TERRAIN_MARGIN = 5.0f;  // Piste avant le départ et après l'arrivée
+const float VOID_DEPTH = 5.0f;      // Sol hors de la piste, sous elle
+const float PIT_DEPTH = 3.0f;       // Fond des trous (Gap)
+const float GAP_LENGTH = 4.0f;
+
+// Demi-dimensions de la boîte où l'obstacle est dessiné : une barre tourne
+// autour de y et balaie sa longueur dans les deux directions horizontales
+glm::vec3 RenderHalfExtents(const Obstacle& obstacle) {
+    glm::vec3 half = obstacle.size * 0.5f;
+    if (obstacle.type == ObstacleType::RotatingBar) half.z = half.x;
+    return half;
+}
+
+} // namespace
+
+Level::Level(Engine::PhysicsEngine* physics, const glm::vec3& origin)
+    : m_physics(physics), m_origin(origin) {
     CreateGround();
 }
 
@@ -13,25 +33,50 @@ Level::~Level() {
     Clear();
 }
 
-void Level::CreateGround() {
-    m_ground = m_physics->CreateRigidBody();
-    m_ground->position = glm::vec3(0.0f, -0.5f, 25.0f);
-    m_ground->boxMin = glm::vec3(-10.0f, -0.5f, -25.0f);
-    m_ground->boxMax = glm::vec3(10.0f, 0.5f, 25.0f);
-    m_ground->isKinematic = true;
-    m_ground->useGravity = false;
+void Level::CreateGround(const std::vector<glm::vec2>& pits) {
+    // Le terrain du moteur est partagé : seule la zone de ce parcours change
+    Engine::Heightfield terrain = m_physics->GetTerrain();
+    float laneHeight = m_origin.y;
+    float startZ = m_origin.z - TERRAIN_MARGIN;
+    float endZ = m_origin.z + m_courseLength + TERRAIN_MARGIN;
+    float edge = LANE_HALF_WIDTH + 2.0f * TERRAIN_CELL;
+    if (terrain.IsFlat()) {
+        // Aucun parcours creusé : repartir de celui-ci, le reste est du vide
+        terrain.Reset(m_origin.x - edge, startZ, TERRAIN_CELL, 2, 2, laneHeight - VOID_DEPTH);
+    }
+    terrain.Cover(m_origin.x - edge, startZ, m_origin.x + edge, endZ, laneHeight - VOID_DEPTH);
+
+    uint32_t firstColumn = terrain.ColumnAt(m_origin.x - LANE_HALF_WIDTH);
+    uint32_t lastColumn = terrain.ColumnAt(m_origin.x + LANE_HALF_WIDTH);
+    for (uint32_t row = terrain.RowAt(startZ); row <= terrain.RowAt(endZ); ++row) {
+        float z = terrain.GetOriginZ() + static_cast<float>(row) * terrain.GetCellSize() - m_origin.z;
+        float height = laneHeight;
+        for (const glm::vec2& pit : pits) {
+            if (z > pit.x && z < pit.y) height = laneHeight - PIT_DEPTH;
+        }
+        for (uint32_t column = firstColumn; column <= lastColumn; ++column) {
+            terrain.SetHeight(column, row, height);
+        }
+    }
+    m_physics->SetTerrain(terrain);
 }
 
 void Level::GenerateObstacleCourse(float length) {
+    std::random_device rd;
+    GenerateObstacleCourse(length, rd());
+}
+
+void Level::GenerateObstacleCourse(float length, uint32_t seed) {
     Clear();
     m_courseLength = length;
+    m_seed = seed;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(seed);
     std::uniform_int_distribution<> obstacleDist(0, 4);
     
     float currentZ = 5.0f; // Commencer après le spawn
     int obstacleCount = 0;
+    std::vector<glm::vec2> pits;
     
     std::cout << "🏭 Génération du parcours d'obstacles..." << std::endl;
     
@@ -40,27 +85,28 @@ void Level::GenerateObstacleCourse(float length) {
         
         switch (type) {
             case ObstacleType::Platform:
-                AddPlatform(glm::vec3(0.0f, 0.0f, currentZ), glm::vec3(3.0f, 0.3f, 2.0f));
+                AddPlatform(m_origin + glm::vec3(0.0f, 0.0f, currentZ), glm::vec3(3.0f, 0.3f, 2.0f));
                 currentZ += 3.0f;
                 break;
                 
             case ObstacleType::RotatingBar:
-                AddRotatingBar(glm::vec3(0.0f, 2.0f, currentZ), 4.0f);
+                AddRotatingBar(m_origin + glm::vec3(0.0f, 2.0f, currentZ), 4.0f);
                 currentZ += 4.0f;
                 break;
                 
             case ObstacleType::MovingPlatform:
-                AddMovingPlatform(glm::vec3(0.0f, 0.5f, currentZ), glm::vec3(2.5f, 0.3f, 2.0f));
+                AddMovingPlatform(m_origin + glm::vec3(0.0f, 0.5f, currentZ), glm::vec3(2.5f, 0.3f, 2.0f));
                 currentZ += 3.5f;
                 break;
                 
             case ObstacleType::Gap:
-                // Trou dans le parcours (pas d'obstacle)
-                currentZ += 4.0f;
+                // Fosse dans le terrain (pas de corps)
+                pits.emplace_back(currentZ, currentZ + GAP_LENGTH);
+                currentZ += GAP_LENGTH;
                 break;
                 
             case ObstacleType::Ramp:
-                AddRamp(glm::vec3(0.0f, 0.0f, currentZ), glm::vec3(3.0f, 1.5f, 3.0f));
+                AddRamp(m_origin + glm::vec3(0.0f, 0.0f, currentZ), glm::vec3(3.0f, 1.5f, 3.0f));
                 currentZ += 4.0f;
                 break;
         }
@@ -69,26 +115,36 @@ void Level::GenerateObstacleCourse(float length) {
     }
     
     // Ligne d'arrivée
-    AddPlatform(glm::vec3(0.0f, 0.0f, length), glm::vec3(5.0f, 0.5f, 3.0f));
+    AddPlatform(m_origin + glm::vec3(0.0f, 0.0f, length), glm::vec3(5.0f, 0.5f, 3.0f));
+    CreateGround(pits);
+
+    // Tout le décor fixe est en place : construire la géométrie statique
+    m_physics->RebuildStaticGeometry();
     
     std::cout << "✅ Parcours généré : " << obstacleCount << " obstacles sur " 
               << static_cast<int>(length) << "m" << std::endl;
 }
 
+Engine::BodyHandle Level::GetFinish() const {
+    // Ajoutée en dernier par GenerateObstacleCourse
+    return m_obstacles.empty() ? Engine::BodyHandle() : m_obstacles.back().body;
+}
+
 void Level::AddPlatform(const glm::vec3& position, const glm::vec3& size) {
     Obstacle obstacle;
     obstacle.type = ObstacleType::Platform;
     obstacle.position = position;
     obstacle.size = size;
     
-    obstacle.body = m_physics->CreateRigidBody();
-    obstacle.body->position = position;
-    obstacle.body->boxMin = -size * 0.5f;
-    obstacle.body->boxMax = size * 0.5f;
-    obstacle.body->isKinematic = true;
-    obstacle.body->useGravity = false;
+    Engine::RigidBody body;
+    body.position = position;
+    body.boxMin = -size * 0.5f;
+    body.boxMax = size * 0.5f;
+    body.isStatic = true;
+    body.useGravity = false;
+    obstacle.body = m_physics->CreateRigidBody(body);
     
-    m_obstacles.push_back(obstacle);
+    PushObstacle(obstacle);
 }
 
 void Level::AddRotatingBar(const glm::vec3& position, float length) {
@@ -98,14 +154,16 @@ void Level::AddRotatingBar(const glm::vec3& position, float length) {
     obstacle.size = glm::vec3(length, 0.3f, 0.3f);
     obstacle.animationSpeed = 1.5f;
     
-    obstacle.body = m_physics->CreateRigidBody();
-    obstacle.body->position = position;
-    obstacle.body->boxMin = glm::vec3(-length * 0.5f, -0.15f, -0.15f);
-    obstacle.body->boxMax = glm::vec3(length * 0.5f, 0.15f, 0.15f);
-    obstacle.body->isKinematic = true;
-    obstacle.body->useGravity = false;
+    Engine::RigidBody body;
+    body.position = position;
+    body.boxMin = glm::vec3(-length * 0.5f, -0.15f, -0.15f);
+    body.boxMax = glm::vec3(length * 0.5f, 0.15f, 0.15f);
+    body.isStatic = true; // Boîte orientée : le BVH garde l'enveloppe de sa rotation
+    body.useGravity = false;
+    obstacle.body = m_physics->CreateRigidBody(body);
+    m_physics->SetOrientation(obstacle.body, glm::mat3(1.0f));
     
-    m_obstacles.push_back(obstacle);
+    PushObstacle(obstacle);
 }
 
 void Level::AddMovingPlatform(const glm::vec3& position, const glm::vec3& size) {
@@ -115,14 +173,15 @@ void Level::AddMovingPlatform(const glm::vec3& position, const glm::vec3& size)
     obstacle.size = size;
     obstacle.animationSpeed = 0.8f;
     
-    obstacle.body = m_physics->CreateRigidBody();
-    obstacle.body->position = position;
-    obstacle.body->boxMin = -size * 0.5f;
-    obstacle.body->boxMax = size * 0.5f;
-    obstacle.body->isKinematic = true;
-    obstacle.body->useGravity = false;
+    Engine::RigidBody body;
+    body.position = position;
+    body.boxMin = -size * 0.5f;
+    body.boxMax = size * 0.5f;
+    body.isKinematic = true;
+    body.useGravity = false;
+    obstacle.body = m_physics->CreateRigidBody(body);
     
-    m_obstacles.push_back(obstacle);
+    PushObstacle(obstacle);
 }
 
 void Level::AddRamp(const glm::vec3& position, const glm::vec3& size) {
@@ -131,14 +190,27 @@ void Level::AddRamp(const glm::vec3& position, const glm::vec3& size) {
     obstacle.position = position;
     obstacle.size = size;
     
-    obstacle.body = m_physics->CreateRigidBody();
-    obstacle.body->position = position;
-    obstacle.body->boxMin = -size * 0.5f;
-    obstacle.body->boxMax = size * 0.5f;
-    obstacle.body->isKinematic = true;
-    obstacle.body->useGravity = false;
+    Engine::RigidBody body;
+    body.position = position;
+    body.boxMin = -size * 0.5f;
+    body.boxMax = size * 0.5f;
+    body.isStatic = true;
+    body.useGravity = false;
+    obstacle.body = m_physics->CreateRigidBody(body);
     
+    PushObstacle(obstacle);
+}
+
+void Level::PushObstacle(const Obstacle& obstacle) {
     m_obstacles.push_back(obstacle);
+    m_renderReachZ = std::max(m_renderReachZ, RenderHalfExtents(obstacle).z);
+}
+
+void Level::UpdateRenderReach() {
+    m_renderReachZ = 0.0f;
+    for (const Obstacle& obstacle : m_obstacles) {
+        m_renderReachZ = std::max(m_renderReachZ, RenderHalfExtents(obstacle).z);
+    }
 }
 
 void Level::Update(float deltaTime) {
@@ -148,19 +220,24 @@ void Level::Update(float deltaTime) {
         // Animer les obstacles
         switch (obstacle.type) {
             case ObstacleType::RotatingBar:
-                // Rotation autour de l'axe Y
-                if (obstacle.body) {
+                // Rotation autour de l'axe Y : la boîte orientée balaie les joueurs
+                if (obstacle.body.IsValid()) {
                     float angle = obstacle.animationTime;
-                    float radius = obstacle.size.x * 0.5f;
-                    // Simulation simple de rotation (juste pour le visuel)
+                    float c = std::cos(angle);
+                    float s = std::sin(angle);
+                    glm::mat3 rotation(glm::vec3(c, 0.0f, -s), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(s, 0.0f, c));
+                    m_physics->SetOrientation(obstacle.body, rotation,
+                                              glm::vec3(0.0f, obstacle.animationSpeed, 0.0f));
                 }
                 break;
                 
             case ObstacleType::MovingPlatform:
                 // Mouvement de gauche à droite
-                if (obstacle.body) {
+                if (obstacle.body.IsValid()) {
                     float offset = std::sin(obstacle.animationTime) * 3.0f;
-                    obstacle.body->position.x = obstacle.position.x + offset;
+                    glm::vec3 position = m_physics->GetPosition(obstacle.body);
+                    position.x = obstacle.position.x + offset;
+                    m_physics->SetPosition(obstacle.body, position);
                 }
                 break;
                 
@@ -170,15 +247,52 @@ void Level::Update(float deltaTime) {
     }
 }
 
-void Level::Render(Engine::Renderer* renderer) {
-    // Dessiner le sol
-    glm::vec3 groundSize = m_ground->boxMax - m_ground->boxMin;
-    renderer->DrawCube(m_ground->position, groundSize, glm::vec3(0.3f, 0.7f, 0.3f));
-    
-    // Dessiner les obstacles
-    for (const auto& obstacle : m_obstacles) {
+void Level::Render(Engine::RenderCommandList& commands, const Engine::Frustum& view) {
+    // Dessiner la piste : un pavé par suite de lignes du terrain à la même
+    // hauteur, seulement sur la tranche de z que couvre la vue
+    const Engine::Heightfield& terrain = m_physics->GetTerrain();
+    uint32_t laneColumn = terrain.ColumnAt(m_origin.x);
+    float startZ = std::max(m_origin.z - TERRAIN_MARGIN, view.boundsMin.z);
+    float endZ = std::min(m_origin.z + m_courseLength + TERRAIN_MARGIN, view.boundsMax.z);
+    uint32_t firstRow = terrain.RowAt(startZ);
+    uint32_t lastRow = terrain.RowAt(endZ);
+    float cell = terrain.GetCellSize();
+    for (uint32_t row = firstRow; startZ <= endZ && row <= lastRow;) {
+        float height = terrain.GetHeight(laneColumn, row);
+        uint32_t end = row;
+        while (end < lastRow && terrain.GetHeight(laneColumn, end + 1) == height) end++;
+
+        float z = terrain.GetOriginZ() + (static_cast<float>(row + end) * 0.5f) * cell;
+        glm::vec3 size(2.0f * LANE_HALF_WIDTH, 1.0f, static_cast<float>(end - row + 1) * cell);
+        glm::vec3 color = height < m_origin.y ? glm::vec3(0.2f, 0.4f, 0.2f) : glm::vec3(0.3f, 0.7f, 0.3f);
+        commands.DrawCube(glm::vec3(m_origin.x, height - 0.5f, z), size, color);
+        row = end + 1;
+    }
+
+    // Obstacles candidats : ceux dont la boîte peut couper la tranche de z de la vue
+    auto first = std::lower_bound(m_obstacles.begin(), m_obstacles.end(), view.boundsMin.z - m_renderReachZ,
+                                  [](const Obstacle& obstacle, float z) { return obstacle.position.z < z; });
+    auto last = std::upper_bound(first, m_obstacles.end(), view.boundsMax.z + m_renderReachZ,
+                                 [](float z, const Obstacle& obstacle) { return z < obstacle.position.z; });
+
+    // Puis le test des plans, par lots SIMD
+    m_cullBoxes.Clear();
+    for (auto it = first; it != last; ++it) {
+        glm::vec3 center = it->body.IsValid() ? m_physics->GetInterpolatedPosition(it->body) : it->position;
+        m_cullBoxes.Add(center, RenderHalfExtents(*it));
+    }
+    m_cullVisible.resize(m_cullBoxes.Size());
+    Engine::CullBoxes(view, m_cullBoxes, m_cullVisible.data(), m_physics->GetSimdLevel());
+
+    // Dessiner les obstacles visibles
+    m_cullStats = CullStats();
+    const size_t offset = static_cast<size_t>(first - m_obstacles.begin());
+    for (size_t k = 0; k < m_cullBoxes.Size(); ++k) {
+        const Obstacle& obstacle = m_obstacles[offset + k];
+        if (!m_cullVisible[k] || !obstacle.body.IsValid()) continue;
+        m_cullStats.drawn++;
+
         glm::vec3 color;
-        
         switch (obstacle.type) {
             case ObstacleType::Platform:
                 color = glm::vec3(0.6f, 0.4f, 0.2f); // Marron
@@ -196,30 +310,48 @@ void Level::Render(Engine::Renderer* renderer) {
                 color = glm::vec3(0.5f, 0.5f, 0.5f);
                 break;
         }
-        
-        if (obstacle.body) {
-            glm::vec3 size = obstacle.body->boxMax - obstacle.body->boxMin;
-            renderer->DrawCube(obstacle.body->position, size, color);
+        // Ligne d'arrivée : dernière plateforme, en vert
+        if (offset + k == m_obstacles.size() - 1) {
+            color = glm::vec3(0.2f, 0.9f, 0.2f);
         }
-    }
-    
-    // Dessiner la ligne d'arrivée (dernière plateforme en vert)
-    if (!m_obstacles.empty()) {
-        const auto& finish = m_obstacles.back();
-        if (finish.body) {
-            glm::vec3 size = finish.body->boxMax - finish.body->boxMin;
-            renderer->DrawCube(finish.body->position, size, glm::vec3(0.2f, 0.9f, 0.2f));
+
+        glm::vec3 center(m_cullBoxes.centerX[k], m_cullBoxes.centerY[k], m_cullBoxes.centerZ[k]);
+        if (obstacle.type == ObstacleType::RotatingBar) {
+            // GetBoxSize rend l'AABB englobante : dessiner la boîte elle-même
+            commands.DrawBox(center, obstacle.size, m_physics->GetOrientation(obstacle.body), color);
+        } else {
+            commands.DrawCube(center, m_physics->GetBoxSize(obstacle.body), color);
         }
     }
+    m_cullStats.culled = m_obstacles.size() - m_cullStats.drawn;
+}
+
+void Level::SaveState(Engine::SnapshotWriter& writer) const {
+    writer.WriteArray(m_obstacles);
+    writer.Write(m_courseLength);
+    writer.Write(m_seed);
+}
+
+bool Level::LoadState(Engine::SnapshotReader& reader) {
+    reader.ReadArray(m_obstacles);
+    reader.Read(m_courseLength);
+    reader.Read(m_seed);
+    UpdateRenderReach();
+    return reader.IsValid();
 }
 
 void Level::Clear() {
+    // Libérer les corps des obstacles (le terrain est conservé)
+    for (const auto& obstacle : m_obstacles) {
+        m_physics->RemoveRigidBody(obstacle.body);
+    }
     m_obstacles.clear();
+    m_renderReachZ = 0.0f;
 }
 
 void Level::Reset() {
     // Régénérer le même parcours
-    GenerateObstacleCourse(m_courseLength);
+    GenerateObstacleCourse(m_courseLength, m_seed);
 }
 
 } // namespace Game
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../engine/physics.h"
-#include "../engine/renderer.h"
+#include "../engine/frustum.h"
+#include "../engine/render_commands.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -21,40 +23,74 @@ struct Obstacle {
     ObstacleType type;
     glm::vec3 position;
     glm::vec3 size;
-    Engine::RigidBody* body = nullptr;
+    Engine::BodyHandle body;
     
     // Pour les obstacles animés
     float animationTime = 0.0f;
     float animationSpeed = 1.0f;
 };
 
+// Obstacles dessinés et écartés par le dernier Render
+struct CullStats {
+    size_t drawn = 0;
+    size_t culled = 0;
+};
+
 // Générateur de niveau procédural
 class Level {
 public:
-    explicit Level(Engine::PhysicsEngine* physics);
+    // origin : décalage de tout le parcours (sol compris), pour en placer
+    // plusieurs côte à côte dans le même monde. Le sol est une piste du
+    // terrain du moteur (Heightfield), bordée de vide.
+    explicit Level(Engine::PhysicsEngine* physics, const glm::vec3& origin = glm::vec3(0.0f));
     ~Level();
     
-    // Génération
+    // Génération (même graine = même parcours)
     void GenerateObstacleCourse(float length);
+    void GenerateObstacleCourse(float length, uint32_t seed);
+    uint32_t GetSeed() const { return m_seed; }
+    float GetCourseLength() const { return m_courseLength; }
+    // Plateforme d'arrivée (invalide avant la génération)
+    Engine::BodyHandle GetFinish() const;
     void Clear();
     void Reset();
     
-    // Mise à jour et rendu
+    // Obstacles et temps d'animation (l'état des corps est dans le moteur)
+    void SaveState(Engine::SnapshotWriter& writer) const;
+    bool LoadState(Engine::SnapshotReader& reader);
+    
+    // Mise à jour et rendu. Seuls la piste et les obstacles qui coupent view
+    // sont dessinés : coût proportionnel à la vue, pas à la longueur du parcours
     void Update(float deltaTime);
-    void Render(Engine::Renderer* renderer);
+    void Render(Engine::RenderCommandList& commands, const Engine::Frustum& view);
+    const CullStats& GetCullStats() const { return m_cullStats; }
     
 private:
-    void CreateGround();
+    // Piste à la hauteur de l'origine sur toute la longueur, creusée d'une
+    // fosse sur chaque intervalle [début, fin] de pits (z relatifs à l'origine)
+    void CreateGround(const std::vector<glm::vec2>& pits = {});
     void AddPlatform(const glm::vec3& position, const glm::vec3& size);
     void AddRotatingBar(const glm::vec3& position, float length);
     void AddMovingPlatform(const glm::vec3& position, const glm::vec3& size);
     void AddRamp(const glm::vec3& position, const glm::vec3& size);
+    // Ajoute à la fin (z croissants) en gardant m_renderReachZ à jour
+    void PushObstacle(const Obstacle& obstacle);
+    void UpdateRenderReach();
     
     Engine::PhysicsEngine* m_physics;
+    // Triés par z de départ (ordre de génération ; les obstacles ne bougent
+    // pas en z) : Render y trouve la vue par dichotomie
     std::vector<Obstacle> m_obstacles;
-    Engine::RigidBody* m_ground;
+    float m_renderReachZ = 0.0f; // Plus grande demi-étendue en z d'un obstacle dessiné
+
+    // Tampons du culling, gardés d'une frame à l'autre
+    Engine::AabbBatch m_cullBoxes;
+    std::vector<uint8_t> m_cullVisible;
+    CullStats m_cullStats;
     
+    glm::vec3 m_origin;
     float m_courseLength = 50.0f;
+    uint32_t m_seed = 0;
 };
 
 } // namespace Game
\ No newline at end of file
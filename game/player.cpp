@@ -1,10 +1,11 @@
 #include "player.h"
+#include <algorithm>
 #include <iostream>
 
 namespace Game {
 
-Player::Player(Engine::PhysicsEngine* physics)
-    : m_physics(physics) {
+Player::Player(Engine::PhysicsEngine* physics, const glm::vec3& startPosition)
+    : m_physics(physics), m_startPosition(startPosition) {
     CreateRagdoll();
 }
 
@@ -13,93 +14,25 @@ Player::~Player() {
 }
 
 void Player::CreateRagdoll() {
-    // Tête
-    m_head = m_physics->CreateRigidBody();
-    m_head->position = m_startPosition + glm::vec3(0.0f, 1.5f, 0.0f);
-    m_head->boxMin = glm::vec3(-0.2f, -0.2f, -0.2f);
-    m_head->boxMax = glm::vec3(0.2f, 0.2f, 0.2f);
-    m_head->mass = 3.0f;
-    m_head->restitution = 0.2f;
-    
-    // Torse
-    m_torso = m_physics->CreateRigidBody();
-    m_torso->position = m_startPosition + glm::vec3(0.0f, 0.8f, 0.0f);
-    m_torso->boxMin = glm::vec3(-0.3f, -0.4f, -0.15f);
-    m_torso->boxMax = glm::vec3(0.3f, 0.4f, 0.15f);
-    m_torso->mass = 10.0f;
-    m_torso->restitution = 0.3f;
-    
-    // Bassin
-    m_pelvis = m_physics->CreateRigidBody();
-    m_pelvis->position = m_startPosition + glm::vec3(0.0f, 0.2f, 0.0f);
-    m_pelvis->boxMin = glm::vec3(-0.25f, -0.15f, -0.15f);
-    m_pelvis->boxMax = glm::vec3(0.25f, 0.15f, 0.15f);
-    m_pelvis->mass = 8.0f;
-    m_pelvis->restitution = 0.3f;
-    
-    // Cuisse gauche
-    m_leftThigh = m_physics->CreateRigidBody();
-    m_leftThigh->position = m_startPosition + glm::vec3(-0.2f, -0.3f, 0.0f);
-    m_leftThigh->boxMin = glm::vec3(-0.12f, -0.4f, -0.12f);
-    m_leftThigh->boxMax = glm::vec3(0.12f, 0.4f, 0.12f);
-    m_leftThigh->mass = 5.0f;
-    m_leftThigh->restitution = 0.4f;
-    
-    // Cuisse droite
-    m_rightThigh = m_physics->CreateRigidBody();
-    m_rightThigh->position = m_startPosition + glm::vec3(0.2f, -0.3f, 0.0f);
-    m_rightThigh->boxMin = glm::vec3(-0.12f, -0.4f, -0.12f);
-    m_rightThigh->boxMax = glm::vec3(0.12f, 0.4f, 0.12f);
-    m_rightThigh->mass = 5.0f;
-    m_rightThigh->restitution = 0.4f;
-    
-    // Mollet gauche
-    m_leftCalf = m_physics->CreateRigidBody();
-    m_leftCalf->position = m_startPosition + glm::vec3(-0.2f, -1.1f, 0.0f);
-    m_leftCalf->boxMin = glm::vec3(-0.1f, -0.4f, -0.1f);
-    m_leftCalf->boxMax = glm::vec3(0.1f, 0.4f, 0.1f);
-    m_leftCalf->mass = 3.0f;
-    m_leftCalf->restitution = 0.5f;
-    m_leftCalf->friction = 0.8f;
-    
-    // Mollet droit
-    m_rightCalf = m_physics->CreateRigidBody();
-    m_rightCalf->position = m_startPosition + glm::vec3(0.2f, -1.1f, 0.0f);
-    m_rightCalf->boxMin = glm::vec3(-0.1f, -0.4f, -0.1f);
-    m_rightCalf->boxMax = glm::vec3(0.1f, 0.4f, 0.1f);
-    m_rightCalf->mass = 3.0f;
-    m_rightCalf->restitution = 0.5f;
-    m_rightCalf->friction = 0.8f;
-    
-    // Bras gauche
-    m_leftArm = m_physics->CreateRigidBody();
-    m_leftArm->position = m_startPosition + glm::vec3(-0.5f, 0.6f, 0.0f);
-    m_leftArm->boxMin = glm::vec3(-0.1f, -0.4f, -0.1f);
-    m_leftArm->boxMax = glm::vec3(0.1f, 0.4f, 0.1f);
-    m_leftArm->mass = 2.0f;
-    m_leftArm->restitution = 0.3f;
-    
-    // Bras droit
-    m_rightArm = m_physics->CreateRigidBody();
-    m_rightArm->position = m_startPosition + glm::vec3(0.5f, 0.6f, 0.0f);
-    m_rightArm->boxMin = glm::vec3(-0.1f, -0.4f, -0.1f);
-    m_rightArm->boxMax = glm::vec3(0.1f, 0.4f, 0.1f);
-    m_rightArm->mass = 2.0f;
-    m_rightArm->restitution = 0.3f;
-    
-    // Stocker toutes les parties
-    m_bodyParts = {m_head, m_torso, m_pelvis, m_leftThigh, m_rightThigh,
-                   m_leftCalf, m_rightCalf, m_leftArm, m_rightArm};
-    
-    // Créer les contraintes (articulations)
-    m_physics->AddConstraint(m_head, m_torso, 0.4f);         // Cou
-    m_physics->AddConstraint(m_torso, m_pelvis, 0.4f);       // Colonne
-    m_physics->AddConstraint(m_pelvis, m_leftThigh, 0.3f);   // Hanche gauche
-    m_physics->AddConstraint(m_pelvis, m_rightThigh, 0.3f);  // Hanche droite
-    m_physics->AddConstraint(m_leftThigh, m_leftCalf, 0.4f); // Genou gauche
-    m_physics->AddConstraint(m_rightThigh, m_rightCalf, 0.4f); // Genou droit
-    m_physics->AddConstraint(m_torso, m_leftArm, 0.5f);      // Épaule gauche
-    m_physics->AddConstraint(m_torso, m_rightArm, 0.5f);     // Épaule droite
+    // Une partie par entrée de la table, puis les articulations en un bloc.
+    // Chaque groupe de la table devient un groupe du moteur propre à ce ragdoll.
+    uint32_t groups[RagdollPartCount + 1] = {};
+    for (size_t p = 0; p < RagdollPartCount; ++p) {
+        const RagdollPartDesc& desc = RAGDOLL_PARTS[p];
+        if (desc.collisionGroup != 0 && groups[desc.collisionGroup] == 0) {
+            groups[desc.collisionGroup] = m_physics->CreateCollisionGroup();
+        }
+        Engine::RigidBody part;
+        part.position = m_startPosition + desc.offset.ToVec3();
+        part.boxMin = -desc.halfExtents.ToVec3();
+        part.boxMax = desc.halfExtents.ToVec3();
+        part.mass = desc.mass;
+        part.restitution = desc.restitution;
+        part.friction = desc.friction;
+        part.collisionGroup = groups[desc.collisionGroup];
+        m_parts[p] = m_physics->CreateRigidBody(part);
+    }
+    m_physics->AddSkeleton<RAGDOLL_TOPOLOGY>(m_parts.data());
 }
 
 void Player::LiftLeftLeg() {
@@ -107,11 +40,11 @@ void Player::LiftLeftLeg() {
     
     // Appliquer une force vers le haut et en avant sur la jambe gauche
     glm::vec3 force(0.0f, 400.0f, 150.0f);
-    m_physics->ApplyForce(m_leftCalf, force);
-    m_physics->ApplyForce(m_leftThigh, force * 0.5f);
+    m_physics->ApplyForce(m_parts[LeftCalf], force);
+    m_physics->ApplyForce(m_parts[LeftThigh], force * 0.5f);
     
     // Force vers l'avant sur le bassin pour avancer
-    m_physics->ApplyForce(m_pelvis, glm::vec3(0.0f, 0.0f, 80.0f));
+    m_physics->ApplyForce(m_parts[Pelvis], glm::vec3(0.0f, 0.0f, 80.0f));
     
     m_leftLegCooldown = 0.3f;
     
@@ -123,11 +56,11 @@ void Player::LiftRightLeg() {
     
     // Appliquer une force vers le haut et en avant sur la jambe droite
     glm::vec3 force(0.0f, 400.0f, 150.0f);
-    m_physics->ApplyForce(m_rightCalf, force);
-    m_physics->ApplyForce(m_rightThigh, force * 0.5f);
+    m_physics->ApplyForce(m_parts[RightCalf], force);
+    m_physics->ApplyForce(m_parts[RightThigh], force * 0.5f);
     
     // Force vers l'avant sur le bassin pour avancer
-    m_physics->ApplyForce(m_pelvis, glm::vec3(0.0f, 0.0f, 80.0f));
+    m_physics->ApplyForce(m_parts[Pelvis], glm::vec3(0.0f, 0.0f, 80.0f));
     
     m_rightLegCooldown = 0.3f;
     
@@ -137,32 +70,37 @@ void Player::LiftRightLeg() {
 void Player::LeanForward() {
     // Pencher le torse vers l'avant
     glm::vec3 force(0.0f, -50.0f, 100.0f);
-    m_physics->ApplyForce(m_torso, force);
-    m_physics->ApplyForce(m_head, force * 0.5f);
+    m_physics->ApplyForce(m_parts[Torso], force);
+    m_physics->ApplyForce(m_parts[Head], force * 0.5f);
 }
 
 void Player::LeanBackward() {
     // Pencher le torse vers l'arrière
     glm::vec3 force(0.0f, -50.0f, -100.0f);
-    m_physics->ApplyForce(m_torso, force);
-    m_physics->ApplyForce(m_head, force * 0.5f);
+    m_physics->ApplyForce(m_parts[Torso], force);
+    m_physics->ApplyForce(m_parts[Head], force * 0.5f);
 }
 
 void Player::Jump() {
     if (m_jumpCooldown > 0.0f) return;
     
-    // Vérifier si on est au sol
+    // Vérifier si on est au sol : un rayon vers le bas depuis chaque partie,
+    // un peu plus long que sa demi-hauteur, touche le sol ou une plateforme
+    Engine::QueryFilter filter;
+    filter.ignore = m_parts.data();
+    filter.ignoreCount = m_parts.size();
+
     bool onGround = false;
-    for (auto* part : m_bodyParts) {
-        if (part->position.y < 1.0f) {
-            onGround = true;
-            break;
-        }
+    for (size_t p = 0; p < m_parts.size() && !onGround; ++p) {
+        Engine::RaycastHit hit;
+        float reach = RAGDOLL_PARTS[p].halfExtents.y + GROUND_PROBE_MARGIN;
+        onGround = m_physics->Raycast(m_physics->GetPosition(m_parts[p]), glm::vec3(0.0f, -1.0f, 0.0f),
+                                      reach, hit, filter);
     }
     
     if (onGround) {
         // Appliquer une impulsion vers le haut sur toutes les parties
-        for (auto* part : m_bodyParts) {
+        for (const auto& part : m_parts) {
             m_physics->ApplyImpulse(part, glm::vec3(0.0f, 150.0f, 0.0f));
         }
         m_jumpCooldown = 1.0f;
@@ -175,100 +113,87 @@ void Player::Update(float deltaTime) {
     if (m_leftLegCooldown > 0.0f) m_leftLegCooldown -= deltaTime;
     if (m_rightLegCooldown > 0.0f) m_rightLegCooldown -= deltaTime;
     if (m_jumpCooldown > 0.0f) m_jumpCooldown -= deltaTime;
-    
-    // Vérifier si le joueur est tombé trop bas
-    glm::vec3 pos = GetPosition();
-    if (pos.y < -10.0f) {
+}
+
+void Player::OnContact(const Engine::ContactEvent& contact) {
+    // Seuls les appuis d'une partie sur le sol comptent (bodyA invalide)
+    if (m_fallen || contact.type == Engine::ContactEventType::End) return;
+    if (contact.bodyA.IsValid() || !IsPart(contact.bodyB)) return;
+
+    if (contact.point.y < m_startPosition.y - FALL_DROP) {
+        m_fallen = true;
         std::cout << "⚠️  Tu es tombé ! Recommence avec R" << std::endl;
     }
 }
 
-void Player::Render(Engine::Renderer* renderer) {
-    // Couleurs pour les différentes parties
-    glm::vec3 headColor(1.0f, 0.8f, 0.7f);    // Beige
-    glm::vec3 torsoColor(0.2f, 0.4f, 0.8f);   // Bleu
-    glm::vec3 limbColor(0.3f, 0.5f, 0.9f);    // Bleu clair
-    glm::vec3 legColor(0.15f, 0.3f, 0.6f);    // Bleu foncé
-    
-    // Dessiner chaque partie du corps
-    renderer->DrawSphere(m_head->position, 0.4f, headColor);
-    
-    renderer->DrawCube(m_torso->position,
-                      m_torso->boxMax - m_torso->boxMin,
-                      torsoColor);
-    
-    renderer->DrawCube(m_pelvis->position,
-                      m_pelvis->boxMax - m_pelvis->boxMin,
-                      torsoColor);
-    
-    renderer->DrawCube(m_leftThigh->position,
-                      m_leftThigh->boxMax - m_leftThigh->boxMin,
-                      legColor);
-    
-    renderer->DrawCube(m_rightThigh->position,
-                      m_rightThigh->boxMax - m_rightThigh->boxMin,
-                      legColor);
-    
-    renderer->DrawCube(m_leftCalf->position,
-                      m_leftCalf->boxMax - m_leftCalf->boxMin,
-                      limbColor);
-    
-    renderer->DrawCube(m_rightCalf->position,
-                      m_rightCalf->boxMax - m_rightCalf->boxMin,
-                      limbColor);
-    
-    renderer->DrawCube(m_leftArm->position,
-                      m_leftArm->boxMax - m_leftArm->boxMin,
-                      limbColor);
-    
-    renderer->DrawCube(m_rightArm->position,
-                      m_rightArm->boxMax - m_rightArm->boxMin,
-                      limbColor);
+bool Player::IsPart(Engine::BodyHandle body) const {
+    return std::find(m_parts.begin(), m_parts.end(), body) != m_parts.end();
+}
+
+void Player::Render(Engine::RenderCommandList& commands) {
+    // Formes et couleurs viennent de la table ; une lecture de position par partie
+    glm::vec3 positions[RagdollPartCount];
+    for (size_t p = 0; p < RagdollPartCount; ++p) {
+        const RagdollPartDesc& desc = RAGDOLL_PARTS[p];
+        positions[p] = m_physics->GetInterpolatedPosition(m_parts[p]);
+        if (desc.sphereRadius > 0.0f) {
+            commands.DrawSphere(positions[p], desc.sphereRadius, desc.color.ToVec3());
+        } else {
+            commands.DrawCube(positions[p], desc.halfExtents.ToVec3() * 2.0f, desc.color.ToVec3());
+        }
+    }
     
     // Dessiner les articulations (lignes)
-    glm::vec3 jointColor(0.9f, 0.9f, 0.1f);
-    renderer->DrawLine(m_head->position, m_torso->position, jointColor);
-    renderer->DrawLine(m_torso->position, m_pelvis->position, jointColor);
-    renderer->DrawLine(m_pelvis->position, m_leftThigh->position, jointColor);
-    renderer->DrawLine(m_pelvis->position, m_rightThigh->position, jointColor);
-    renderer->DrawLine(m_leftThigh->position, m_leftCalf->position, jointColor);
-    renderer->DrawLine(m_rightThigh->position, m_rightCalf->position, jointColor);
-    renderer->DrawLine(m_torso->position, m_leftArm->position, jointColor);
-    renderer->DrawLine(m_torso->position, m_rightArm->position, jointColor);
+    for (const Engine::SkeletonJoint& joint : RAGDOLL_TOPOLOGY.joints) {
+        commands.DrawLine(positions[joint.parent], positions[joint.child], RAGDOLL_JOINT_COLOR.ToVec3());
+    }
 }
 
 glm::vec3 Player::GetPosition() const {
     // Position moyenne du corps (centre de masse approximatif)
     glm::vec3 sum(0.0f);
-    for (auto* part : m_bodyParts) {
-        sum += part->position;
+    for (const auto& part : m_parts) {
+        sum += m_physics->GetPosition(part);
     }
-    return sum / static_cast<float>(m_bodyParts.size());
+    return sum / static_cast<float>(m_parts.size());
+}
+
+void Player::SaveState(Engine::SnapshotWriter& writer) const {
+    writer.Write(m_parts);
+    writer.Write(m_startPosition);
+    writer.Write(m_leftLegCooldown);
+    writer.Write(m_rightLegCooldown);
+    writer.Write(m_jumpCooldown);
+    writer.Write(m_fallen);
+}
+
+bool Player::LoadState(Engine::SnapshotReader& reader) {
+    reader.Read(m_parts);
+    reader.Read(m_startPosition);
+    reader.Read(m_leftLegCooldown);
+    reader.Read(m_rightLegCooldown);
+    reader.Read(m_jumpCooldown);
+    reader.Read(m_fallen);
+    return reader.IsValid();
 }
 
 void Player::Reset() {
-    // Réinitialiser toutes les parties du corps
-    float yOffset = 1.5f;
-    m_head->position = m_startPosition + glm::vec3(0.0f, yOffset, 0.0f);
-    m_torso->position = m_startPosition + glm::vec3(0.0f, yOffset - 0.7f, 0.0f);
-    m_pelvis->position = m_startPosition + glm::vec3(0.0f, yOffset - 1.3f, 0.0f);
-    m_leftThigh->position = m_startPosition + glm::vec3(-0.2f, yOffset - 1.8f, 0.0f);
-    m_rightThigh->position = m_startPosition + glm::vec3(0.2f, yOffset - 1.8f, 0.0f);
-    m_leftCalf->position = m_startPosition + glm::vec3(-0.2f, yOffset - 2.6f, 0.0f);
-    m_rightCalf->position = m_startPosition + glm::vec3(0.2f, yOffset - 2.6f, 0.0f);
-    m_leftArm->position = m_startPosition + glm::vec3(-0.5f, yOffset - 0.9f, 0.0f);
-    m_rightArm->position = m_startPosition + glm::vec3(0.5f, yOffset - 0.9f, 0.0f);
+    // Réinitialiser toutes les parties du corps à leur place dans la table
+    for (size_t p = 0; p < RagdollPartCount; ++p) {
+        m_physics->SetPosition(m_parts[p], m_startPosition + RAGDOLL_PARTS[p].offset.ToVec3());
+    }
     
     // Reset des vélocités
-    for (auto* part : m_bodyParts) {
-        part->velocity = glm::vec3(0.0f);
-        part->force = glm::vec3(0.0f);
+    for (const auto& part : m_parts) {
+        m_physics->SetVelocity(part, glm::vec3(0.0f));
+        m_physics->ClearForces(part);
     }
     
     // Reset des cooldowns
     m_leftLegCooldown = 0.0f;
     m_rightLegCooldown = 0.0f;
     m_jumpCooldown = 0.0f;
+    m_fallen = false;
 }
 
 } // namespace Game
\ No newline at end of file
@@ -1,16 +1,18 @@
 #pragma once
 
 #include "../engine/physics.h"
-#include "../engine/renderer.h"
+#include "../engine/render_commands.h"
+#include "ragdoll.h"
+#include <array>
 #include <glm/glm.hpp>
-#include <vector>
 
 namespace Game {
 
-// Le personnage ragdoll avec physique
+// Le personnage ragdoll avec physique (parties et articulations : ragdoll.h)
 class Player {
 public:
-    explicit Player(Engine::PhysicsEngine* physics);
+    // startPosition : position du ragdoll au départ et après Reset
+    explicit Player(Engine::PhysicsEngine* physics, const glm::vec3& startPosition = glm::vec3(0.0f, 3.0f, 0.0f));
     ~Player();
     
     // Commandes
@@ -22,11 +24,26 @@ public:
     
     // Mise à jour et rendu
     void Update(float deltaTime);
-    void Render(Engine::Renderer* renderer);
+    void Render(Engine::RenderCommandList& commands);
     
     // Position
     glm::vec3 GetPosition() const;
     void Reset();
+
+    // Parties du ragdoll, indexées par RagdollPart
+    const std::array<Engine::BodyHandle, RagdollPartCount>& GetParts() const { return m_parts; }
+    bool IsPart(Engine::BodyHandle body) const;
+
+    // Événements du moteur (GetContactEvents), à transmettre après chaque
+    // Update physique et avant Update ; ceux des autres corps sont ignorés
+    void OnContact(const Engine::ContactEvent& contact);
+    // Une partie a touché le sol sous le niveau de la piste (vide autour,
+    // fond d'une fosse) depuis le dernier Reset
+    bool HasFallen() const { return m_fallen; }
+
+    // Cooldowns et handles des parties (l'état des corps est dans le moteur)
+    void SaveState(Engine::SnapshotWriter& writer) const;
+    bool LoadState(Engine::SnapshotReader& reader);
     
 private:
     void CreateRagdoll();
@@ -34,26 +51,21 @@ private:
     
     Engine::PhysicsEngine* m_physics;
     
-    // Parties du corps (ragdoll)
-    Engine::RigidBody* m_head;
-    Engine::RigidBody* m_torso;
-    Engine::RigidBody* m_pelvis;
-    Engine::RigidBody* m_leftThigh;
-    Engine::RigidBody* m_rightThigh;
-    Engine::RigidBody* m_leftCalf;
-    Engine::RigidBody* m_rightCalf;
-    Engine::RigidBody* m_leftArm;
-    Engine::RigidBody* m_rightArm;
-    
-    std::vector<Engine::RigidBody*> m_bodyParts;
+    // Parties du corps, indexées par RagdollPart
+    std::array<Engine::BodyHandle, RagdollPartCount> m_parts;
     
     // Position initiale
-    glm::vec3 m_startPosition{0.0f, 3.0f, 0.0f};
+    glm::vec3 m_startPosition;
     
     // Cooldowns pour les mouvements
     float m_leftLegCooldown = 0.0f;
     float m_rightLegCooldown = 0.0f;
     float m_jumpCooldown = 0.0f;
+
+    bool m_fallen = false;
+
+    const float GROUND_PROBE_MARGIN = 0.15f; // Sous une partie, pour être "au sol"
+    const float FALL_DROP = 4.0f;            // Sous le départ (3 m au-dessus de la piste)
 };
 
 } // namespace Game
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../engine/skeleton.h"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Game {
+
+// Parties du ragdoll, dans l'ordre de la table
+enum RagdollPart : uint8_t {
+    Head,
+    Torso,
+    Pelvis,
+    LeftThigh,
+    RightThigh,
+    LeftCalf,
+    RightCalf,
+    LeftArm,
+    RightArm,
+    RagdollPartCount
+};
+
+struct RagdollFloat3 {
+    float x, y, z;
+    glm::vec3 ToVec3() const { return glm::vec3(x, y, z); }
+};
+
+// Description d'une partie : création, Reset et rendu
+struct RagdollPartDesc {
+    RagdollFloat3 offset;      // Par rapport à la position de départ
+    RagdollFloat3 halfExtents; // Demi-taille de la boîte de collision
+    float mass;
+    float restitution;
+    float friction;
+    RagdollFloat3 color;
+    float sphereRadius;        // > 0 : dessinée comme une sphère
+    uint8_t collisionGroup;    // 0 : touche les autres parties ; sinon pas celles du même groupe
+};
+
+// Groupe de collision des parties qui ne se touchent pas entre elles
+constexpr uint8_t RAGDOLL_BODY_GROUP = 1;
+
+constexpr RagdollFloat3 RAGDOLL_HEAD_COLOR{1.0f, 0.8f, 0.7f};   // Beige
+constexpr RagdollFloat3 RAGDOLL_TORSO_COLOR{0.2f, 0.4f, 0.8f};  // Bleu
+constexpr RagdollFloat3 RAGDOLL_LIMB_COLOR{0.3f, 0.5f, 0.9f};   // Bleu clair
+constexpr RagdollFloat3 RAGDOLL_LEG_COLOR{0.15f, 0.3f, 0.6f};   // Bleu foncé
+constexpr RagdollFloat3 RAGDOLL_JOINT_COLOR{0.9f, 0.9f, 0.1f};
+
+// Toutes les parties partagent un groupe : les boîtes se chevauchent sans être
+// reliées (bras dans le torse, tête contre les bras), un contact entre elles
+// combattrait les articulations et le ragdoll ne se poserait jamais
+constexpr RagdollPartDesc RAGDOLL_PARTS[RagdollPartCount] = {
+    // offset                 demi-taille               masse rebond frott. couleur              sphère groupe
+    {{0.0f, 1.5f, 0.0f},    {0.2f, 0.2f, 0.2f},    3.0f, 0.2f, 0.3f, RAGDOLL_HEAD_COLOR,  0.4f, RAGDOLL_BODY_GROUP}, // Tête
+    {{0.0f, 0.8f, 0.0f},    {0.3f, 0.4f, 0.15f},  10.0f, 0.3f, 0.3f, RAGDOLL_TORSO_COLOR, 0.0f, RAGDOLL_BODY_GROUP}, // Torse
+    {{0.0f, 0.2f, 0.0f},    {0.25f, 0.15f, 0.15f}, 8.0f, 0.3f, 0.3f, RAGDOLL_TORSO_COLOR, 0.0f, RAGDOLL_BODY_GROUP}, // Bassin
+    {{-0.2f, -0.3f, 0.0f},  {0.12f, 0.4f, 0.12f},  5.0f, 0.4f, 0.3f, RAGDOLL_LEG_COLOR,   0.0f, RAGDOLL_BODY_GROUP}, // Cuisse gauche
+    {{0.2f, -0.3f, 0.0f},   {0.12f, 0.4f, 0.12f},  5.0f, 0.4f, 0.3f, RAGDOLL_LEG_COLOR,   0.0f, RAGDOLL_BODY_GROUP}, // Cuisse droite
+    {{-0.2f, -1.1f, 0.0f},  {0.1f, 0.4f, 0.1f},    3.0f, 0.5f, 0.8f, RAGDOLL_LIMB_COLOR,  0.0f, RAGDOLL_BODY_GROUP}, // Mollet gauche
+    {{0.2f, -1.1f, 0.0f},   {0.1f, 0.4f, 0.1f},    3.0f, 0.5f, 0.8f, RAGDOLL_LIMB_COLOR,  0.0f, RAGDOLL_BODY_GROUP}, // Mollet droit
+    {{-0.5f, 0.6f, 0.0f},   {0.1f, 0.4f, 0.1f},    2.0f, 0.3f, 0.3f, RAGDOLL_LIMB_COLOR,  0.0f, RAGDOLL_BODY_GROUP}, // Bras gauche
+    {{0.5f, 0.6f, 0.0f},    {0.1f, 0.4f, 0.1f},    2.0f, 0.3f, 0.3f, RAGDOLL_LIMB_COLOR,  0.0f, RAGDOLL_BODY_GROUP}, // Bras droit
+};
+
+// Player crée au plus un groupe du moteur par numéro de la table
+constexpr bool RagdollGroupsInRange() {
+    for (const RagdollPartDesc& desc : RAGDOLL_PARTS) {
+        if (desc.collisionGroup > RagdollPartCount) return false;
+    }
+    return true;
+}
+static_assert(RagdollGroupsInRange(), "ragdoll : groupe de collision hors limites");
+
+// Articulations (parent, enfant, longueur au repos), résolues dans cet ordre
+constexpr Engine::SkeletonTopology<RagdollPartCount, 8> RAGDOLL_TOPOLOGY = {{
+    {Head, Torso, 0.4f},           // Cou
+    {Torso, Pelvis, 0.4f},         // Colonne
+    {Pelvis, LeftThigh, 0.3f},     // Hanche gauche
+    {Pelvis, RightThigh, 0.3f},    // Hanche droite
+    {LeftThigh, LeftCalf, 0.4f},   // Genou gauche
+    {RightThigh, RightCalf, 0.4f}, // Genou droit
+    {Torso, LeftArm, 0.5f},        // Épaule gauche
+    {Torso, RightArm, 0.5f},       // Épaule droite
+}};
+
+} // namespace Game
@@ -0,0 +1,138 @@
+#include "world_batch.h"
+#include "../engine/thread_pool.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+namespace Game {
+
+void World::Save(Engine::SnapshotBlob& blob) const {
+    Engine::SnapshotWriter writer(blob);
+    physics->SaveState(writer);
+    player->SaveState(writer);
+    level->SaveState(writer);
+    writer.Write(time);
+}
+
+bool World::Restore(const Engine::SnapshotBlob& blob) {
+    Engine::SnapshotReader reader(blob);
+    return physics->LoadState(reader) &&
+           player->LoadState(reader) &&
+           level->LoadState(reader) &&
+           reader.Read(time) &&
+           reader.AtEnd();
+}
+
+WorldBatch::WorldBatch(size_t worldCount, size_t threadCount, float courseLength, uint32_t firstSeed)
+    : m_worlds(worldCount), m_seeds(worldCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_threadPool = std::make_unique<Engine::ThreadPool>(threadCount);
+
+    // La génération des parcours est indépendante d'un monde à l'autre
+    m_threadPool->Run(worldCount, [&](size_t i) {
+        World& world = m_worlds[i];
+        m_seeds[i] = firstSeed + static_cast<uint32_t>(i);
+        world.physics = std::make_unique<Engine::PhysicsEngine>();
+        world.player = std::make_unique<Player>(world.physics.get());
+        world.level = std::make_unique<Level>(world.physics.get());
+        world.level->GenerateObstacleCourse(courseLength, m_seeds[i]);
+    });
+
+    Rebalance();
+}
+
+WorldBatch::~WorldBatch() {}
+
+void WorldBatch::Step(float deltaTime, const WorldController& controller) {
+    // Les parcours régénérés peuvent changer le nombre de corps
+    bool changed = false;
+    for (size_t i = 0; i < m_worlds.size() && !changed; ++i) {
+        changed = m_worlds[i].physics->GetBodies().Size() != m_binnedBodyCounts[i];
+    }
+    if (changed) {
+        Rebalance();
+    }
+
+    m_threadPool->Run(m_binOffsets.size() - 1, [&](size_t bin) {
+        for (size_t k = m_binOffsets[bin]; k < m_binOffsets[bin + 1]; ++k) {
+            StepWorld(m_binWorlds[k], deltaTime, controller);
+        }
+    });
+}
+
+void WorldBatch::StepWorld(size_t index, float deltaTime, const WorldController& controller) {
+    World& world = m_worlds[index];
+    if (controller) {
+        controller(index, world);
+    }
+
+    // Même ordre que la boucle de jeu
+    world.physics->Update(deltaTime);
+    for (const Engine::ContactEvent& contact : world.physics->GetContactEvents()) {
+        world.player->OnContact(contact);
+    }
+    world.player->Update(deltaTime);
+    world.level->Update(deltaTime);
+    world.time += deltaTime;
+}
+
+void WorldBatch::ResetAll() {
+    m_threadPool->Run(m_worlds.size(), [this](size_t i) { ResetWorld(i); });
+}
+
+void WorldBatch::ResetWorlds(const std::vector<size_t>& worlds) {
+    m_threadPool->Run(worlds.size(), [&](size_t k) { ResetWorld(worlds[k]); });
+}
+
+void WorldBatch::ResetWorld(size_t index) {
+    World& world = m_worlds[index];
+    if (world.level->GetSeed() != m_seeds[index]) {
+        world.level->GenerateObstacleCourse(world.level->GetCourseLength(), m_seeds[index]);
+    } else {
+        world.level->Reset();
+    }
+    world.player->Reset();
+    world.time = 0.0f;
+}
+
+void WorldBatch::Rebalance() {
+    // Plus gros mondes d'abord, chacun dans le lot le moins chargé (LPT)
+    const size_t worldCount = m_worlds.size();
+    const size_t binCount = std::max<size_t>(1, std::min(worldCount, m_threadPool->GetThreadCount()));
+
+    m_binnedBodyCounts.resize(worldCount);
+    for (size_t i = 0; i < worldCount; ++i) {
+        m_binnedBodyCounts[i] = m_worlds[i].physics->GetBodies().Size();
+    }
+
+    std::vector<uint32_t> order(worldCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return m_binnedBodyCounts[a] > m_binnedBodyCounts[b];
+    });
+
+    std::vector<size_t> loads(binCount, 0);
+    std::vector<uint32_t> binOf(worldCount);
+    std::vector<size_t> binSizes(binCount, 0);
+    for (uint32_t world : order) {
+        size_t bin = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        binOf[world] = static_cast<uint32_t>(bin);
+        loads[bin] += m_binnedBodyCounts[world];
+        binSizes[bin]++;
+    }
+
+    m_binOffsets.assign(binCount + 1, 0);
+    for (size_t bin = 0; bin < binCount; ++bin) {
+        m_binOffsets[bin + 1] = m_binOffsets[bin] + binSizes[bin];
+    }
+
+    m_binWorlds.resize(worldCount);
+    std::vector<size_t> cursor(m_binOffsets.begin(), m_binOffsets.end() - 1);
+    for (uint32_t world : order) {
+        m_binWorlds[cursor[binOf[world]]++] = world;
+    }
+}
+
+} // namespace Game
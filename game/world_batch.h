@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../engine/physics.h"
+#include "player.h"
+#include "level.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+class ThreadPool;
+}
+
+namespace Game {
+
+// Un monde indépendant : son moteur physique, son joueur et son niveau
+// (détruits dans l'ordre inverse : le moteur en dernier)
+struct World {
+    std::unique_ptr<Engine::PhysicsEngine> physics;
+    std::unique_ptr<Level> level;
+    std::unique_ptr<Player> player;
+    float time = 0.0f; // Temps écoulé depuis le dernier Reset
+
+    // Instantané complet du monde (moteur, joueur, niveau) pour rollback ou
+    // branchement ; réutiliser le même tampon évite les allocations
+    void Save(Engine::SnapshotBlob& blob) const;
+    bool Restore(const Engine::SnapshotBlob& blob);
+};
+
+// Appelé pour chaque monde avant son pas, depuis un thread du lot :
+// ne doit toucher qu'au monde reçu
+using WorldController = std::function<void(size_t worldIndex, World& world)>;
+
+// Lot de mondes headless simulés ensemble (évaluation de contrôleurs,
+// parcours générés). Chaque Step avance tous les mondes d'un pas, répartis
+// sur un pool de threads ; les mondes sont regroupés par nombre de corps
+// pour que chaque thread ait à peu près la même charge.
+class WorldBatch {
+public:
+    // Le monde i génère son parcours avec la graine firstSeed + i
+    WorldBatch(size_t worldCount, size_t threadCount, float courseLength = 50.0f, uint32_t firstSeed = 1);
+    ~WorldBatch();
+
+    WorldBatch(const WorldBatch&) = delete;
+    WorldBatch& operator=(const WorldBatch&) = delete;
+
+    size_t GetWorldCount() const { return m_worlds.size(); }
+    World& GetWorld(size_t index) { return m_worlds[index]; }
+    const World& GetWorld(size_t index) const { return m_worlds[index]; }
+
+    // Un pas pour chaque monde : contrôleur, physique, joueur, niveau
+    void Step(float deltaTime, const WorldController& controller = nullptr);
+
+    // Remise à zéro en bloc (en parallèle). Une graine différente de celle
+    // du monde régénère son parcours ; sinon le même parcours est rejoué.
+    void ResetAll();
+    void ResetWorlds(const std::vector<size_t>& worlds);
+    void SetSeed(size_t world, uint32_t seed) { m_seeds[world] = seed; }
+
+    // Répartition courante : mondes du lot b = GetBinWorlds()[GetBinOffsets()[b], GetBinOffsets()[b + 1])
+    const std::vector<uint32_t>& GetBinWorlds() const { return m_binWorlds; }
+    const std::vector<size_t>& GetBinOffsets() const { return m_binOffsets; }
+
+private:
+    void StepWorld(size_t index, float deltaTime, const WorldController& controller);
+    void ResetWorld(size_t index);
+    void Rebalance();
+
+    std::vector<World> m_worlds;
+    std::vector<uint32_t> m_seeds;
+    std::unique_ptr<Engine::ThreadPool> m_threadPool;
+
+    // Lots par thread (plus long d'abord, glouton vers le lot le moins chargé)
+    std::vector<uint32_t> m_binWorlds;
+    std::vector<size_t> m_binOffsets;
+    std::vector<size_t> m_binnedBodyCounts; // Nombre de corps au dernier équilibrage
+};
+
+} // namespace Game
@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include "engine/physics.h"
 #include "engine/renderer.h"
 #include "engine/input.h"
+#include "engine/triple_buffer.h"
 #include "game/player.h"
 #include "game/level.h"
 
@@ -11,7 +18,151 @@ const int WINDOW_WIDTH = 1280;
 const int WINDOW_HEIGHT = 720;
 const char* WINDOW_TITLE = "Wobbly Runner 3D - Atteins la ligne d'arrivée !";
 
-int main() {
+// Fréquence de la simulation physique (indépendante du rafraîchissement)
+const float PHYSICS_RATE_HZ = 120.0f;
+
+// Rendu hors écran (--offscreen) : cadence de l'horloge d'images et durée par défaut
+const int OFFSCREEN_FPS = 60;
+const int OFFSCREEN_DEFAULT_FRAMES = 600;
+
+#if defined(WOBBLY_PROFILING)
+// Profil de la physique écrit en quittant
+const char* PROFILE_CSV_PATH = "physics_profile.csv";
+const char* PROFILE_JSON_PATH = "physics_profile.json";
+#endif
+
+namespace {
+
+// Actions du joueur lues au clavier, un bit chacune (transmises telles quelles
+// au thread de simulation)
+enum PlayerCommand : uint32_t {
+    Command_LeftLeg = 1 << 0,
+    Command_RightLeg = 1 << 1,
+    Command_LeanForward = 1 << 2,
+    Command_LeanBackward = 1 << 3,
+    Command_Jump = 1 << 4,
+    Command_Reset = 1 << 5
+};
+
+uint32_t ReadCommands(const Engine::InputSystem& input) {
+    uint32_t commands = 0;
+    if (input.IsKeyPressed(GLFW_KEY_Q)) commands |= Command_LeftLeg;
+    if (input.IsKeyPressed(GLFW_KEY_D)) commands |= Command_RightLeg;
+    if (input.IsKeyPressed(GLFW_KEY_Z)) commands |= Command_LeanForward;
+    if (input.IsKeyPressed(GLFW_KEY_S)) commands |= Command_LeanBackward;
+    if (input.IsKeyPressed(GLFW_KEY_SPACE)) commands |= Command_Jump;
+    if (input.IsKeyPressed(GLFW_KEY_R)) commands |= Command_Reset;
+    return commands;
+}
+
+// Partie en cours : tout ce qui avance avec la simulation
+struct Session {
+    Engine::PhysicsEngine* physics;
+    Game::Player* player;
+    Game::Level* level;
+    bool gameWon = false;
+    float gameTime = 0.0f;
+};
+
+// Un pas de jeu : commandes, physique, joueur, niveau puis victoire
+void Simulate(Session& session, uint32_t commands, float deltaTime) {
+    Game::Player* player = session.player;
+    Game::Level* level = session.level;
+    session.gameTime += deltaTime;
+
+    if (commands & Command_LeftLeg) player->LiftLeftLeg();
+    if (commands & Command_RightLeg) player->LiftRightLeg();
+    if (commands & Command_LeanForward) player->LeanForward();
+    if (commands & Command_LeanBackward) player->LeanBackward();
+    if (commands & Command_Jump) player->Jump();
+    if (commands & Command_Reset) {
+        player->Reset();
+        level->Reset();
+        session.gameWon = false;
+        session.gameTime = 0.0f;
+        std::cout << "🔄 Niveau recommencé !" << std::endl;
+    }
+
+    // Mise à jour physique
+    session.physics->Update(deltaTime);
+
+    // Contacts de cet Update : le joueur suit ses appuis, et la victoire
+    // tombe dès qu'une de ses parties touche l'arrivée
+    bool reachedFinish = false;
+    Engine::BodyHandle finish = level->GetFinish();
+    for (const Engine::ContactEvent& contact : session.physics->GetContactEvents()) {
+        player->OnContact(contact);
+        if (contact.type != Engine::ContactEventType::Begin) continue;
+        reachedFinish |= (contact.bodyA == finish && player->IsPart(contact.bodyB)) ||
+                         (contact.bodyB == finish && player->IsPart(contact.bodyA));
+    }
+
+    player->Update(deltaTime);
+    level->Update(deltaTime);
+
+    // Vérification de la victoire
+    if (!session.gameWon && reachedFinish) {
+        session.gameWon = true;
+        std::cout << "\n🎉🎉🎉 VICTOIRE ! 🎉🎉🎉" << std::endl;
+        std::cout << "Temps: " << static_cast<int>(session.gameTime) << " secondes" << std::endl;
+        std::cout << "Tu as survécu au parcours de Wobby !\n" << std::endl;
+    }
+}
+
+// Image d'un instant de la simulation : commandes de dessin (positions,
+// orientations, couleurs) et caméra. Immuable une fois publiée.
+struct RenderSnapshot {
+    Engine::RenderCommandList commands;
+    glm::vec3 cameraPosition{0.0f};
+    glm::vec3 cameraTarget{0.0f};
+};
+
+void Capture(const Session& session, const Engine::Renderer& renderer, RenderSnapshot& snapshot) {
+    // Caméra qui suit le joueur
+    glm::vec3 playerPos = session.player->GetPosition();
+    snapshot.cameraPosition = playerPos + glm::vec3(0.0f, 5.0f, -10.0f);
+    snapshot.cameraTarget = playerPos;
+
+    // Le niveau ne dessine que ce que cette caméra voit
+    Engine::Frustum view = Engine::Frustum::FromMatrix(
+        renderer.GetProjectionMatrix() * renderer.GetViewMatrix(snapshot.cameraPosition, snapshot.cameraTarget));
+
+    snapshot.commands.Clear();
+    session.level->Render(snapshot.commands, view);
+    session.player->Render(snapshot.commands);
+}
+
+void Present(Engine::Renderer* renderer, const RenderSnapshot& snapshot) {
+    renderer->BeginFrame();
+    renderer->SetCameraPosition(snapshot.cameraPosition);
+    renderer->SetCameraTarget(snapshot.cameraTarget);
+    renderer->Submit(snapshot.commands);
+    renderer->EndFrame();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // --render-thread : la simulation tourne sur son propre thread et publie ses
+    // instantanés, le thread principal (contexte GL, fenêtre) dessine le dernier
+    // --offscreen : sans fenêtre ni GPU (EGL), --frames images à OFFSCREEN_FPS
+    // --capture fichier.{raw,ppm,y4m} : chaque image écrite dans le fichier
+    bool renderThread = false;
+    bool offscreen = false;
+    int offscreenFrames = OFFSCREEN_DEFAULT_FRAMES;
+    const char* capturePath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--render-thread") == 0) renderThread = true;
+        else if (std::strcmp(argv[i], "--offscreen") == 0) offscreen = true;
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) offscreenFrames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) capturePath = argv[++i];
+    }
+    if (offscreen && renderThread) {
+        // L'horloge d'images avance au rythme du rendu : une seule boucle
+        std::cout << "ℹ️  --render-thread ignoré avec --offscreen" << std::endl;
+        renderThread = false;
+    }
+
     std::cout << "=================================" << std::endl;
     std::cout << "  🎮 WOBBLY RUNNER 3D 🎮  " << std::endl;
     std::cout << "=================================" << std::endl;
@@ -27,17 +178,34 @@ int main() {
     try {
         // Initialisation du renderer
         auto renderer = std::make_unique<Engine::Renderer>();
-        if (!renderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE)) {
+        bool ready = offscreen ? renderer->InitializeOffscreen(WINDOW_WIDTH, WINDOW_HEIGHT, OFFSCREEN_FPS)
+                               : renderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
+        if (!ready) {
             std::cerr << "❌ Erreur: Impossible d'initialiser le renderer" << std::endl;
             return -1;
         }
 
-        // Initialisation du système d'input
-        auto inputSystem = std::make_unique<Engine::InputSystem>(renderer->GetWindow());
+        if (capturePath) {
+            Engine::CaptureFormat format;
+            if (!Engine::CaptureFormatFromPath(capturePath, format)) {
+                std::cerr << "❌ Erreur: Format de capture inconnu (.raw, .ppm ou .y4m) : " << capturePath << std::endl;
+                return -1;
+            }
+            if (!renderer->StartCapture(capturePath, format)) {
+                return -1;
+            }
+        }
+
+        // Initialisation du système d'input (pas de clavier hors écran)
+        std::unique_ptr<Engine::InputSystem> inputSystem;
+        if (!offscreen) {
+            inputSystem = std::make_unique<Engine::InputSystem>(renderer->GetWindow());
+        }
 
         // Initialisation du moteur de physique
         auto physics = std::make_unique<Engine::PhysicsEngine>();
         physics->SetGravity({0.0f, -9.81f, 0.0f});
+        physics->SetFixedTimestep(PHYSICS_RATE_HZ);
 
         // Création du joueur
         auto player = std::make_unique<Game::Player>(physics.get());
@@ -46,81 +214,93 @@ int main() {
         auto level = std::make_unique<Game::Level>(physics.get());
         level->GenerateObstacleCourse(50.0f); // Parcours de 50m
 
-        // Variables de temps
-        float lastTime = 0.0f;
-        float deltaTime = 0.0f;
-        
-        bool gameWon = false;
-        float gameTime = 0.0f;
+        Session session{physics.get(), player.get(), level.get()};
 
         std::cout << "✅ Jeu initialisé ! Bonne chance !\n" << std::endl;
 
-        // Boucle de jeu principale
-        while (!renderer->ShouldClose()) {
-            // Calcul du temps
-            float currentTime = renderer->GetTime();
-            deltaTime = currentTime - lastTime;
-            lastTime = currentTime;
-            gameTime += deltaTime;
-
-            // Input
-            inputSystem->Update();
-            
-            // Commandes du joueur
-            if (inputSystem->IsKeyPressed(GLFW_KEY_Q)) {
-                player->LiftLeftLeg();
-            }
-            if (inputSystem->IsKeyPressed(GLFW_KEY_D)) {
-                player->LiftRightLeg();
-            }
-            if (inputSystem->IsKeyPressed(GLFW_KEY_Z)) {
-                player->LeanForward();
-            }
-            if (inputSystem->IsKeyPressed(GLFW_KEY_S)) {
-                player->LeanBackward();
-            }
-            if (inputSystem->IsKeyPressed(GLFW_KEY_SPACE)) {
-                player->Jump();
-            }
-            if (inputSystem->IsKeyPressed(GLFW_KEY_R)) {
-                player->Reset();
-                level->Reset();
-                gameWon = false;
-                gameTime = 0.0f;
-                std::cout << "🔄 Niveau recommencé !" << std::endl;
+        if (renderThread) {
+            // Le thread principal garde la fenêtre (GLFW l'exige) : c'est lui qui
+            // dessine, la simulation part sur un thread à elle
+            Engine::TripleBuffer<RenderSnapshot> snapshots;
+            std::atomic<uint32_t> commands{0};
+            std::atomic<bool> running{true};
+
+            std::thread simulation([&]() {
+                using Clock = std::chrono::steady_clock;
+                const auto tick = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<float>(1.0f / PHYSICS_RATE_HZ));
+                auto nextTick = Clock::now();
+                float lastTime = renderer->GetTime(); // glfwGetTime : sûr depuis tout thread
+                while (running.load(std::memory_order_relaxed)) {
+                    float currentTime = renderer->GetTime();
+                    Simulate(session, commands.load(std::memory_order_relaxed), currentTime - lastTime);
+                    lastTime = currentTime;
+
+                    Capture(session, *renderer, snapshots.GetWriteBuffer());
+                    snapshots.Publish();
+
+                    // Un tour par pas physique : plus souvent ne ferait que tourner à vide
+                    nextTick = std::max(nextTick + tick, Clock::now());
+                    std::this_thread::sleep_until(nextTick);
+                }
+            });
+
+            while (!renderer->ShouldClose()) {
+                inputSystem->Update();
+                commands.store(ReadCommands(*inputSystem), std::memory_order_relaxed);
+
+                // Dernier instantané complet ; sinon le précédent est redessiné
+                snapshots.Acquire();
+                Present(renderer.get(), snapshots.GetReadBuffer());
             }
 
-            // Mise à jour physique
-            physics->Update(deltaTime);
-            player->Update(deltaTime);
-            level->Update(deltaTime);
-
-            // Vérification de la victoire
-            if (!gameWon && player->GetPosition().z >= 50.0f) {
-                gameWon = true;
-                std::cout << "\n🎉🎉🎉 VICTOIRE ! 🎉🎉🎉" << std::endl;
-                std::cout << "Temps: " << static_cast<int>(gameTime) << " secondes" << std::endl;
-                std::cout << "Tu as survécu au parcours de Wobby !\n" << std::endl;
+            running.store(false, std::memory_order_relaxed);
+            simulation.join();
+        } else {
+            RenderSnapshot snapshot;
+            float lastTime = 0.0f;
+
+            // Boucle de jeu principale (hors écran : offscreenFrames images)
+            for (int frame = 0; !renderer->ShouldClose() && (!offscreen || frame < offscreenFrames); ++frame) {
+                // Calcul du temps
+                float currentTime = renderer->GetTime();
+                float deltaTime = currentTime - lastTime;
+                lastTime = currentTime;
+
+                uint32_t commands = 0;
+                if (inputSystem) {
+                    inputSystem->Update();
+                    commands = ReadCommands(*inputSystem);
+                }
+                Simulate(session, commands, deltaTime);
+
+                Capture(session, *renderer, snapshot);
+                Present(renderer.get(), snapshot);
             }
+        }
+
+        // Images encore en vol écrites avant le bilan ; une capture
+        // incomplète (--frames N) donne un code d'erreur
+        const bool captureComplete = renderer->StopCapture();
 
-            // Rendu
-            renderer->BeginFrame();
-            
-            // Caméra qui suit le joueur
-            glm::vec3 playerPos = player->GetPosition();
-            renderer->SetCameraPosition(playerPos + glm::vec3(0.0f, 5.0f, -10.0f));
-            renderer->SetCameraTarget(playerPos);
-
-            // Rendu du niveau
-            level->Render(renderer.get());
-            
-            // Rendu du joueur
-            player->Render(renderer.get());
-
-            renderer->EndFrame();
+        const Game::CullStats& culling = level->GetCullStats();
+        std::cout << "👁️  Dernière image : " << culling.drawn << " obstacles dessinés, " << culling.culled
+                  << " écartés par le culling" << std::endl;
+
+#if defined(WOBBLY_PROFILING)
+        // Dernières secondes de physique, phase par phase
+        const auto& profiler = physics->GetProfiler();
+        if (profiler.WriteCsv(PROFILE_CSV_PATH) && profiler.WriteJson(PROFILE_JSON_PATH)) {
+            Engine::PhysicsProfileFrame average = profiler.GetAverage();
+            std::cout << "⏱️  Physique : " << average.updateMicros << " µs par Update en moyenne ("
+                      << PROFILE_CSV_PATH << ", " << PROFILE_JSON_PATH << ")" << std::endl;
         }
+#endif
 
         std::cout << "\n👋 Merci d'avoir joué à Wobbly Runner 3D !" << std::endl;
+        if (!captureComplete) {
+            return -1;
+        }
 
     } catch (const std::exception& e) {
         std::cerr << "❌ Erreur fatale: " << e.what() << std::endl;
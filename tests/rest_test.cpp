@@ -0,0 +1,103 @@
+// Contacts au repos : un ragdoll lâché sur un sol plat doit s'endormir sans
+// glisser (ses parties ne se repoussent pas entre elles), et une pile de six
+// boîtes sur une dalle statique doit tenir debout et s'endormir.
+// Code de retour 1 en cas d'échec.
+#include "engine/physics.h"
+#include "game/player.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const float DT = 1.0f / 120.0f;
+const int STEPS = 1200;
+const float MAX_DRIFT = 0.03f;              // Glissement horizontal toléré du centre de masse (m)
+const float STACK_SINK_PER_CONTACT = 0.015f; // Enfoncement toléré par contact de la pile (m)
+
+glm::vec3 CenterOfMass(const Engine::PhysicsEngine& physics, const Game::Player& player) {
+    const Engine::BodyStore& bodies = physics.GetBodies();
+    glm::vec3 sum(0.0f);
+    float mass = 0.0f;
+    for (Engine::BodyHandle part : player.GetParts()) {
+        uint32_t i = bodies.DenseIndex(part);
+        sum += bodies.mass[i] * bodies.Position(i);
+        mass += bodies.mass[i];
+    }
+    return sum / mass;
+}
+
+// Le glissement dépendait du point d'apparition : plusieurs points
+int CheckRagdoll(const glm::vec3& spawn) {
+    Engine::PhysicsEngine physics;
+    Game::Player player(&physics, spawn);
+    const glm::vec3 start = CenterOfMass(physics, player);
+    for (int s = 0; s < STEPS; ++s) {
+        physics.Update(DT);
+    }
+
+    glm::vec3 end = CenterOfMass(physics, player);
+    float drift = std::sqrt((end.x - start.x) * (end.x - start.x) + (end.z - start.z) * (end.z - start.z));
+    bool asleep = true;
+    for (Engine::BodyHandle part : player.GetParts()) {
+        asleep = asleep && physics.IsSleeping(part);
+    }
+    if (asleep && drift <= MAX_DRIFT) return 0;
+
+    std::printf("échec : ragdoll lâché en (%.1f, %.1f, %.1f) : %s, glissement %.3f m\n",
+                spawn.x, spawn.y, spawn.z, asleep ? "endormi" : "toujours éveillé", drift);
+    return 1;
+}
+
+int CheckStack() {
+    Engine::PhysicsEngine physics;
+    Engine::RigidBody ground;
+    ground.position = glm::vec3(0.0f, -0.5f, 0.0f);
+    ground.boxMin = glm::vec3(-20.0f, -0.5f, -20.0f);
+    ground.boxMax = glm::vec3(20.0f, 0.5f, 20.0f);
+    ground.isStatic = true;
+    physics.CreateRigidBody(ground);
+
+    std::vector<Engine::BodyHandle> boxes;
+    for (int k = 0; k < 6; ++k) {
+        Engine::RigidBody box;
+        // Légèrement décalées, comme une pile posée à la main
+        box.position = glm::vec3(0.01f * static_cast<float>(k), 0.5f + static_cast<float>(k), 0.02f * static_cast<float>(k));
+        boxes.push_back(physics.CreateRigidBody(box));
+    }
+    for (int s = 0; s < STEPS; ++s) {
+        physics.Update(DT);
+    }
+
+    int failures = 0;
+    for (int k = 0; k < 6; ++k) {
+        glm::vec3 position = physics.GetPosition(boxes[k]);
+        // Chaque contact garde un léger recouvrement (marge du solveur)
+        float expectedY = 0.5f + static_cast<float>(k);
+        float tolerance = STACK_SINK_PER_CONTACT * static_cast<float>(k + 1);
+        if (std::abs(position.y - expectedY) > tolerance || !physics.IsSleeping(boxes[k])) {
+            std::printf("échec : boîte %d de la pile en y = %.3f (attendu %.3f), %s\n", k, position.y, expectedY,
+                        physics.IsSleeping(boxes[k]) ? "endormie" : "éveillée");
+            failures++;
+        }
+    }
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    // Les messages du joueur ne concernent pas le test
+    std::cout.setstate(std::ios::failbit);
+
+    int failures = 0;
+    for (const glm::vec3& spawn : {glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(6.5f, 3.0f, 0.0f),
+                                   glm::vec3(0.0f, 3.0f, 18.0f), glm::vec3(6.5f, 3.0f, 18.0f)}) {
+        failures += CheckRagdoll(spawn);
+    }
+    failures += CheckStack();
+
+    std::printf("%s\n", failures == 0 ? "ok" : "ÉCHEC");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+// Mise en sommeil des îlots : un corps lancé vers le haut ne doit jamais
+// s'endormir en l'air (la fenêtre de 60 pas peut encadrer son apogée), et un
+// corps posé sur le sol doit finir par s'endormir.
+// Code de retour 1 en cas d'échec.
+#include "engine/physics.h"
+#include <cstdio>
+
+namespace {
+
+const float DT = 1.0f / 120.0f;
+const int STEPS = 600;
+
+Engine::RigidBody Box(float y) {
+    Engine::RigidBody box;
+    box.position = glm::vec3(0.0f, y, 0.0f);
+    box.boxMin = glm::vec3(-0.2f);
+    box.boxMax = glm::vec3(0.2f);
+    box.mass = 1.0f;
+    return box;
+}
+
+// Hauteur de repos d'une boîte sur le sol, sommeil désactivé
+float RestHeight() {
+    Engine::PhysicsEngine physics;
+    physics.SetSleepingEnabled(false);
+    Engine::BodyHandle box = physics.CreateRigidBody(Box(1.0f));
+    for (int s = 0; s < STEPS; ++s) {
+        physics.Update(DT);
+    }
+    return physics.GetPosition(box).y;
+}
+
+} // namespace
+
+int main() {
+    const float restY = RestHeight();
+    int failures = 0;
+
+    // Vitesses de lancement dont la fenêtre encadrait l'apogée (au départ ou
+    // après un rebond) avec le seul critère du déplacement net
+    for (int k = 0; k < 60; ++k) {
+        const float launchSpeed = 2.0f + 0.02f * static_cast<float>(k);
+        Engine::PhysicsEngine physics;
+        Engine::BodyHandle box = physics.CreateRigidBody(Box(20.0f));
+        physics.SetVelocity(box, glm::vec3(0.0f, launchSpeed, 0.0f));
+
+        for (int s = 0; s < STEPS; ++s) {
+            physics.Update(DT);
+            float y = physics.GetPosition(box).y;
+            if (physics.IsSleeping(box) && y > restY + 0.05f) {
+                std::printf("échec : lancée à %.2f m/s, endormie en l'air au pas %d (y = %.2f, repos %.2f)\n",
+                            launchSpeed, s, y, restY);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    // Le critère ne doit pas empêcher le sommeil d'un corps au repos
+    Engine::PhysicsEngine physics;
+    Engine::BodyHandle box = physics.CreateRigidBody(Box(1.0f));
+    for (int s = 0; s < STEPS; ++s) {
+        physics.Update(DT);
+    }
+    if (!physics.IsSleeping(box)) {
+        std::printf("échec : boîte posée au sol toujours éveillée après %d pas\n", STEPS);
+        failures++;
+    }
+
+    std::printf("%s\n", failures == 0 ? "ok" : "ÉCHEC");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// Instantanés : restaurer un monde puis le sauver redonne exactement les mêmes
+// octets, et rejouer les mêmes commandes depuis un instantané reproduit la
+// simulation bit à bit (moteur, joueur et niveau).
+// Code de retour 1 en cas d'échec.
+#include "game/world_batch.h"
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+const float DT = 1.0f / 120.0f;
+const int STEPS = 240;
+const size_t WORLDS = 2;
+
+// Commandes déterministes, différentes d'un monde à l'autre
+void Drive(size_t worldIndex, Game::World& world) {
+    const int frame = static_cast<int>(world.time / DT + 0.5f) + static_cast<int>(worldIndex) * 5;
+    if (frame % 30 == 0) world.player->LiftLeftLeg();
+    if (frame % 30 == 15) world.player->LiftRightLeg();
+    if (frame % 90 == 45) world.player->Jump();
+    world.player->LeanForward();
+}
+
+void Run(Game::WorldBatch& batch, int steps) {
+    for (int s = 0; s < steps; ++s) {
+        batch.Step(DT, Drive);
+    }
+}
+
+} // namespace
+
+int main() {
+    // Les messages du joueur ne concernent pas le test
+    std::cout.setstate(std::ios::failbit);
+
+    Game::WorldBatch batch(WORLDS, WORLDS, 100.0f, 3);
+    for (size_t i = 0; i < WORLDS; ++i) {
+        batch.GetWorld(i).physics->SetDeterministic(true);
+    }
+    Run(batch, STEPS);
+
+    int failures = 0;
+    std::vector<Engine::SnapshotBlob> saved(WORLDS);
+    for (size_t i = 0; i < WORLDS; ++i) {
+        batch.GetWorld(i).Save(saved[i]);
+    }
+    Run(batch, STEPS);
+    std::vector<Engine::SnapshotBlob> reference(WORLDS);
+    for (size_t i = 0; i < WORLDS; ++i) {
+        batch.GetWorld(i).Save(reference[i]);
+    }
+
+    // Aller-retour : rien ne doit se perdre entre LoadState et SaveState
+    Engine::SnapshotBlob blob;
+    for (size_t i = 0; i < WORLDS; ++i) {
+        if (!batch.GetWorld(i).Restore(saved[i])) {
+            std::printf("échec : monde %zu, instantané refusé\n", i);
+            return 1;
+        }
+        batch.GetWorld(i).Save(blob);
+        if (blob != saved[i]) {
+            std::printf("échec : monde %zu, instantané différent après restauration\n", i);
+            failures++;
+        }
+    }
+
+    // Rejeu : mêmes commandes, même état final
+    Run(batch, STEPS);
+    for (size_t i = 0; i < WORLDS; ++i) {
+        batch.GetWorld(i).Save(blob);
+        if (blob != reference[i]) {
+            std::printf("échec : monde %zu, rejeu différent de la simulation d'origine\n", i);
+            failures++;
+        }
+    }
+
+    // Un instantané tronqué doit être refusé
+    Engine::SnapshotBlob truncated(saved[0].begin(), saved[0].end() - 1);
+    if (batch.GetWorld(0).Restore(truncated)) {
+        std::printf("échec : instantané tronqué accepté\n");
+        failures++;
+    }
+
+    std::printf("%s\n", failures == 0 ? "ok" : "ÉCHEC");
+    return failures == 0 ? 0 : 1;
+}